@@ -29,7 +29,22 @@ LOCAL_SRC_FILES := $(subst $(LOCAL_PATH)/,, \
 	$(LOCAL_PATH)/source/HelloApp.cpp \
 	$(LOCAL_PATH)/source/LevelManager.cpp \
 	$(LOCAL_PATH)/source/main.cpp \
-	$(LOCAL_PATH)/source/PolarPairsController.cpp)
+	$(LOCAL_PATH)/source/PolarPairsController.cpp \
+	$(LOCAL_PATH)/source/TweenEngine.cpp \
+	$(LOCAL_PATH)/source/FrameGovernor.cpp \
+	$(LOCAL_PATH)/source/AssetResidency.cpp \
+	$(LOCAL_PATH)/source/TextureVariants.cpp \
+	$(LOCAL_PATH)/source/SoundEvents.cpp \
+	$(LOCAL_PATH)/source/ProgressWriter.cpp \
+	$(LOCAL_PATH)/source/ProgressStore.cpp \
+	$(LOCAL_PATH)/source/StatsLog.cpp \
+	$(LOCAL_PATH)/source/InputLatency.cpp \
+	$(LOCAL_PATH)/source/SwipeRecognizer.cpp \
+	$(LOCAL_PATH)/source/LockstepSession.cpp \
+	$(LOCAL_PATH)/source/LockstepTransport.cpp \
+	$(LOCAL_PATH)/source/PuzzleBoard.cpp \
+	$(LOCAL_PATH)/source/LevelWatcher.cpp \
+	$(LOCAL_PATH)/source/GridDiff.cpp)
 
 # Link in SDL2
 LOCAL_SHARED_LIBRARIES := SDL2
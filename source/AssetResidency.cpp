@@ -0,0 +1,242 @@
+//
+//  AssetResidency.cpp
+//  PolarPairs
+//
+
+#include "AssetResidency.h"
+
+using namespace cugl;
+
+bool AssetResidency::init(const std::shared_ptr<AssetManager>& assets, size_t budget) {
+    if (!assets) {
+        return false;
+    }
+    _assets = assets;
+    _budget = budget;
+    _clock = 0;
+    return true;
+}
+
+void AssetResidency::dispose() {
+    _groups.clear();
+    _order.clear();
+    _assets = nullptr;
+}
+
+AssetResidency::Group* AssetResidency::find(const std::string& name) {
+    auto it = _groups.find(name);
+    if (it == _groups.end()) {
+        CULog("Unknown asset group: %s", name.c_str());
+        return nullptr;
+    }
+    return &it->second;
+}
+
+bool AssetResidency::addGroup(const std::string& name, const std::vector<std::string>& files, bool pinned) {
+    if (!_assets || _groups.count(name)) {
+        return false;
+    }
+
+    Group group;
+    group.pinned = pinned;
+    for (const std::string& file : files) {
+        auto reader = JsonReader::allocWithAsset(file);
+        auto json = reader ? reader->readJson() : nullptr;
+        if (!json) {
+            CULog("Could not read asset group file: %s", file.c_str());
+            return false;
+        }
+        group.files.push_back(json);
+
+        // Remember the keys so arrival and size can be checked per group
+        if (auto textures = json->get("textures")) {
+            for (size_t i = 0; i < textures->size(); i++) {
+                auto entry = textures->get((int)i);
+                group.textures.emplace_back(entry->key(), entry->getBool("mipmaps", false));
+            }
+        }
+        if (auto sounds = json->get("sounds")) {
+            for (size_t i = 0; i < sounds->size(); i++) {
+                auto entry = sounds->get((int)i);
+                group.sounds.emplace_back(entry->key(), entry->getBool("stream", false));
+            }
+        }
+    }
+
+    // Boot assets are loaded before the groups are registered
+    if (hasArrived(group)) {
+        group.resident = true;
+        group.bytes = measure(group);
+    }
+
+    _groups[name] = group;
+    _order.push_back(name);
+    return true;
+}
+
+bool AssetResidency::hasArrived(const Group& group) const {
+    for (const auto& texture : group.textures) {
+        if (!_assets->get<graphics::Texture>(texture.first)) {
+            return false;
+        }
+    }
+    for (const auto& sound : group.sounds) {
+        if (!_assets->get<audio::Sound>(sound.first)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t AssetResidency::measure(const Group& group) const {
+    size_t bytes = 0;
+    for (const auto& texture : group.textures) {
+        auto asset = _assets->get<graphics::Texture>(texture.first);
+        if (asset) {
+            size_t page = (size_t)asset->getWidth() * (size_t)asset->getHeight() * 4;
+            bytes += texture.second ? page + page / 3 : page;
+        }
+    }
+    for (const auto& sound : group.sounds) {
+        auto asset = _assets->get<audio::Sound>(sound.first);
+        if (asset && !sound.second) {
+            bytes += (size_t)asset->getLength() * asset->getChannels() * sizeof(float);
+        }
+    }
+    return bytes;
+}
+
+void AssetResidency::load(const std::string& name, Group& group) {
+    if (group.resident || group.loading) {
+        return;
+    }
+    CULog("Loading asset group: %s", name.c_str());
+    group.loading = true;
+    for (const auto& json : group.files) {
+        _assets->loadDirectoryAsync(json, nullptr);
+    }
+}
+
+void AssetResidency::evict(const std::string& name, Group& group) {
+    for (const auto& json : group.files) {
+        _assets->unloadDirectory(json);
+    }
+    CULog("Evicted asset group %s (%.1f MB)", name.c_str(), group.bytes / (1024.0f * 1024.0f));
+    group.resident = false;
+    group.bytes = 0;
+}
+
+void AssetResidency::acquire(const std::string& name) {
+    Group* group = find(name);
+    if (group) {
+        group->refs++;
+        group->lastUsed = ++_clock;
+        load(name, *group);
+    }
+}
+
+void AssetResidency::release(const std::string& name) {
+    Group* group = find(name);
+    if (group && group->refs > 0) {
+        group->refs--;
+        group->lastUsed = ++_clock;
+    }
+}
+
+bool AssetResidency::isResident(const std::string& name) const {
+    auto it = _groups.find(name);
+    return it != _groups.end() && it->second.resident;
+}
+
+bool AssetResidency::isResident(const std::vector<std::string>& names) const {
+    for (const std::string& name : names) {
+        if (!isResident(name)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AssetResidency::update() {
+    for (const std::string& name : _order) {
+        Group& group = _groups[name];
+        if (group.loading && hasArrived(group)) {
+            group.loading = false;
+            group.resident = true;
+            group.bytes = measure(group);
+            CULog("Asset group %s resident (%.1f MB)", name.c_str(), group.bytes / (1024.0f * 1024.0f));
+        }
+    }
+
+    // Evict unreferenced groups, oldest first, until back under budget
+    size_t total = getResidentBytes();
+    while (total > _budget) {
+        std::string victim;
+        unsigned long oldest = 0;
+        for (const std::string& name : _order) {
+            const Group& group = _groups[name];
+            if (group.resident && !group.pinned && group.refs == 0 &&
+                (victim.empty() || group.lastUsed < oldest)) {
+                victim = name;
+                oldest = group.lastUsed;
+            }
+        }
+        if (victim.empty()) {
+            break;  // Everything left is in use
+        }
+        Group& group = _groups[victim];
+        total -= group.bytes;
+        evict(victim, group);
+    }
+}
+
+void AssetResidency::setBudget(size_t budget) {
+    _budget = budget;
+    update();
+}
+
+size_t AssetResidency::getBytes(const std::string& name) const {
+    auto it = _groups.find(name);
+    return it != _groups.end() ? it->second.bytes : 0;
+}
+
+size_t AssetResidency::getResidentBytes() const {
+    size_t total = 0;
+    for (const auto& entry : _groups) {
+        total += entry.second.bytes;
+    }
+    return total;
+}
+
+size_t AssetResidency::getSoundBytes(bool streamed) const {
+    size_t bytes = 0;
+    for (const auto& entry : _groups) {
+        if (!entry.second.resident) {
+            continue;
+        }
+        for (const auto& sound : entry.second.sounds) {
+            auto asset = _assets->get<audio::Sound>(sound.first);
+            if (asset && sound.second == streamed) {
+                bytes += (size_t)asset->getLength() * asset->getChannels() * sizeof(float);
+            }
+        }
+    }
+    return bytes;
+}
+
+std::string AssetResidency::getReport() const {
+    const float MB = 1024.0f * 1024.0f;
+    char text[64];
+    snprintf(text, sizeof(text), "assets %.1f/%.0f MB", getResidentBytes() / MB, _budget / MB);
+    std::string report = text;
+    for (const std::string& name : _order) {
+        const Group& group = _groups.at(name);
+        if (group.resident) {
+            snprintf(text, sizeof(text), "  %s %.1f%s", name.c_str(), group.bytes / MB, group.refs > 0 ? "*" : "");
+        } else {
+            snprintf(text, sizeof(text), "  %s %s", name.c_str(), group.loading ? "..." : "-");
+        }
+        report += text;
+    }
+    return report;
+}
@@ -0,0 +1,131 @@
+//
+//  AssetResidency.h
+//  PolarPairs
+//
+
+#ifndef __ASSET_RESIDENCY_H__
+#define __ASSET_RESIDENCY_H__
+
+#include <cugl/cugl.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Keeps scene-scoped groups of assets loaded only while they are needed.
+ *
+ * A group is a set of asset directory files (json/menu.json, an atlas file,
+ * ...). Scenes acquire the groups they draw from and release them when they
+ * leave. Released groups stay loaded until the resident total goes over the
+ * budget; then the least recently used ones are unloaded from the asset
+ * manager. Acquiring an unloaded group loads it again asynchronously, so
+ * callers check isResident() before building nodes from it.
+ *
+ * Resident bytes are estimates: RGBA8 texture pages (plus a third for
+ * mipmaps) and decoded float samples for sounds that are not streamed.
+ * Unloading only frees the memory once no scene node still holds the
+ * textures, so scenes drop their nodes before releasing a group.
+ */
+class AssetResidency {
+public:
+    /** Default budget for resident group memory, in bytes */
+    static constexpr size_t DEFAULT_BUDGET = 48 * 1024 * 1024;
+
+private:
+    /** One group of asset files, loaded and unloaded together */
+    struct Group {
+        std::vector<std::shared_ptr<cugl::JsonValue>> files;
+        // Texture keys, with whether they build mipmaps
+        std::vector<std::pair<std::string, bool>> textures;
+        // Sound keys, with whether they stream from disk (not counted as resident)
+        std::vector<std::pair<std::string, bool>> sounds;
+        bool pinned;
+        int refs;
+        bool loading;
+        bool resident;
+        size_t bytes;
+        unsigned long lastUsed;
+        Group() : pinned(false), refs(0), loading(false), resident(false), bytes(0), lastUsed(0) {}
+    };
+
+    std::shared_ptr<cugl::AssetManager> _assets;
+    std::unordered_map<std::string, Group> _groups;
+    /** Group names in the order they were added, for the report */
+    std::vector<std::string> _order;
+    size_t _budget;
+    /** Use counter for least-recently-used ordering */
+    unsigned long _clock;
+
+    /** Returns true if every texture and sound in the group is in the asset manager */
+    bool hasArrived(const Group& group) const;
+
+    /** Returns the estimated bytes the group's assets occupy */
+    size_t measure(const Group& group) const;
+
+    /** Starts loading the group if it is not loaded or loading */
+    void load(const std::string& name, Group& group);
+
+    /** Unloads the group from the asset manager */
+    void evict(const std::string& name, Group& group);
+
+    /** Returns the named group, or nullptr (with a log message) if it is unknown */
+    Group* find(const std::string& name);
+
+public:
+    AssetResidency() : _budget(DEFAULT_BUDGET), _clock(0) {}
+    ~AssetResidency() { dispose(); }
+
+    /** Sets the asset manager and memory budget */
+    bool init(const std::shared_ptr<cugl::AssetManager>& assets, size_t budget = DEFAULT_BUDGET);
+
+    /** Forgets all groups (the assets stay with the asset manager) */
+    void dispose();
+
+    /**
+     * Registers a group made of the given asset directory files.
+     *
+     * Pinned groups are never evicted. A group whose assets are already in
+     * the asset manager (loaded synchronously at boot) starts resident.
+     */
+    bool addGroup(const std::string& name, const std::vector<std::string>& files, bool pinned = false);
+
+    /** Adds a reference to the group, loading it asynchronously if needed */
+    void acquire(const std::string& name);
+
+    /** Drops a reference; at zero the group may be evicted under budget pressure */
+    void release(const std::string& name);
+
+    /** Returns true if the group is loaded and ready to build nodes from */
+    bool isResident(const std::string& name) const;
+
+    /** Returns true if every listed group is loaded */
+    bool isResident(const std::vector<std::string>& names) const;
+
+    /** Marks finished loads resident and evicts groups while over budget */
+    void update();
+
+    /** Sets the memory budget in bytes and evicts down to it */
+    void setBudget(size_t budget);
+
+    /** Returns the memory budget in bytes */
+    size_t getBudget() const { return _budget; }
+
+    /** Returns the estimated resident bytes of one group (0 if not resident) */
+    size_t getBytes(const std::string& name) const;
+
+    /** Returns the estimated resident bytes of all groups */
+    size_t getResidentBytes() const;
+
+    /**
+     * Returns the decoded size of the sounds in resident groups.
+     *
+     * With streamed true this sums the streamed sounds, which is what they
+     * would take if decoded into memory rather than streamed.
+     */
+    size_t getSoundBytes(bool streamed) const;
+
+    /** Returns a one-line summary of resident megabytes per group */
+    std::string getReport() const;
+};
+
+#endif /* __ASSET_RESIDENCY_H__ */
@@ -0,0 +1,208 @@
+//
+//  FrameGovernor.cpp
+//  PolarPairs
+//
+
+#include "FrameGovernor.h"
+#include <algorithm>
+#include <fstream>
+
+namespace {
+    const char* activityName(FrameGovernor::Activity activity) {
+        switch (activity) {
+            case FrameGovernor::Activity::MOVING:
+                return "moving";
+            case FrameGovernor::Activity::ANIMATING:
+                return "animating";
+            case FrameGovernor::Activity::NONE:
+            default:
+                return "still";
+        }
+    }
+}
+
+FrameGovernor::FrameGovernor() :
+    _historyNext(0), _historyCount(0), _lateCount(0),
+    _target(0), _ceiling(0), _probeDelay(PROBE_DELAY),
+    _quietTime(0), _stableTime(0), _justChanged(false),
+    _activity(Activity::NONE), _clock(0), _logging(false) {
+    std::fill(_history, _history + HISTORY_SIZE, 0.0f);
+    std::fill(_late, _late + HISTORY_SIZE, false);
+}
+
+void FrameGovernor::init() {
+    resetHistory();
+    _ceiling = 0;
+    _probeDelay = PROBE_DELAY;
+    _quietTime = 0;
+    _stableTime = 0;
+    _activity = Activity::NONE;
+    _clock = 0;
+    setTarget(0, "startup");
+}
+
+void FrameGovernor::resetHistory() {
+    _historyNext = 0;
+    _historyCount = 0;
+    _lateCount = 0;
+    std::fill(_late, _late + HISTORY_SIZE, false);
+}
+
+void FrameGovernor::record(float dt) {
+    bool late = dt > LATE_TOLERANCE / RATES[_target];
+
+    // Overwrite the oldest entry once the window is full
+    if (_historyCount == HISTORY_SIZE && _late[_historyNext]) {
+        _lateCount--;
+    }
+    _history[_historyNext] = dt;
+    _late[_historyNext] = late;
+    _historyNext = (_historyNext + 1) % HISTORY_SIZE;
+    _historyCount = std::min(_historyCount + 1, HISTORY_SIZE);
+    if (late) {
+        _lateCount++;
+        _stableTime = 0;
+    } else if (_target == _ceiling) {
+        _stableTime += dt;
+    }
+}
+
+void FrameGovernor::setTarget(int index, const char* reason) {
+    if (index != _target) {
+        CULog("Frame governor: %.0f -> %.0f FPS (%s)", RATES[_target], RATES[index], reason);
+    }
+    _target = index;
+    _justChanged = true;
+    resetHistory();
+    cugl::Application::get()->setFPS(RATES[_target]);
+}
+
+float FrameGovernor::update(float dt, Activity activity) {
+    _clock += dt;
+    _activity = activity;
+
+    // Judge the frame against the rate it ran at; the frame right after a
+    // change still waited on the old interval
+    bool judged = !_justChanged;
+    _justChanged = false;
+    if (judged) {
+        record(dt);
+    }
+
+    if (_logging) {
+        char line[96];
+        snprintf(line, sizeof(line), "%.3f,%.2f,%.0f,%.0f,%s,%d\n", _clock, dt * 1000.0f,
+                 RATES[_target], RATES[_ceiling], activityName(activity),
+                 judged && dt > LATE_TOLERANCE / RATES[_target] ? 1 : 0);
+        _logBuffer += line;
+        if (_logBuffer.size() > 8192) {
+            flushLog();
+        }
+    }
+
+    if (activity == Activity::NONE) {
+        _quietTime += dt;
+    } else {
+        _quietTime = 0;
+    }
+
+    // Never slow down in the middle of a move; cap and probe decisions wait
+    bool moving = activity == Activity::MOVING;
+    if (!moving && _target == _ceiling) {
+        if (_lateCount >= LATE_LIMIT && _ceiling < RATE_COUNT - 1) {
+            CULog("Frame governor: %d of %d frames late at %.0f FPS, capping at %.0f FPS",
+                  _lateCount, _historyCount, RATES[_ceiling], RATES[_ceiling + 1]);
+            _ceiling++;
+            _probeDelay *= 2.0f;  // Wait longer before each new probe
+            _stableTime = 0;
+        } else if (_ceiling > 0 && activity != Activity::NONE && _stableTime >= _probeDelay) {
+            CULog("Frame governor: stable for %.0fs, probing %.0f FPS", _stableTime, RATES[_ceiling - 1]);
+            _ceiling--;
+            _stableTime = 0;
+        }
+    }
+
+    // Busy frames run at the cap, then wait and idle at the lower rates
+    int desired = 0;
+    const char* reason = "active";
+    if (_quietTime >= IDLE_DELAY) {
+        desired = RATE_COUNT - 1;
+        reason = "idle";
+    } else if (_quietTime >= ACTIVE_HOLD) {
+        desired = 1;
+        reason = "waiting";
+    }
+    if (desired < _ceiling) {
+        desired = _ceiling;
+        reason = "capped";
+    }
+
+    float step = dt;
+    if (desired != _target && !(moving && desired > _target)) {
+        bool faster = desired < _target;
+        setTarget(desired, reason);
+        if (faster) {
+            step = std::min(dt, 1.0f / RATES[_target]);
+        }
+    }
+    return step;
+}
+
+float FrameGovernor::getAverageFrameTime() const {
+    if (_historyCount == 0) {
+        return 1.0f / RATES[_target];
+    }
+    float total = 0;
+    for (int i = 0; i < _historyCount; i++) {
+        total += _history[i];
+    }
+    return total / _historyCount;
+}
+
+float FrameGovernor::getWorstFrameTime() const {
+    float worst = 0;
+    for (int i = 0; i < _historyCount; i++) {
+        worst = std::max(worst, _history[i]);
+    }
+    return worst;
+}
+
+std::string FrameGovernor::getReadout() const {
+    float average = getAverageFrameTime();
+    char text[128];
+    snprintf(text, sizeof(text), "%.0f/%.0f FPS cap %.0f  %.1fms max %.1fms  late %d  %s%s",
+             average > 0 ? 1.0f / average : 0.0f, RATES[_target], RATES[_ceiling],
+             average * 1000.0f, getWorstFrameTime() * 1000.0f, _lateCount,
+             activityName(_activity), _logging ? "  [log]" : "");
+    return text;
+}
+
+void FrameGovernor::setLogging(bool logging) {
+    if (logging == _logging) {
+        return;
+    }
+    if (logging) {
+        _logPath = cugl::Application::get()->getSaveDirectory() + "frametimes.csv";
+        std::ofstream file(_logPath);
+        if (!file.is_open()) {
+            CULog("Could not open frame-time log at: %s", _logPath.c_str());
+            return;
+        }
+        file << "time,dt_ms,target_fps,cap_fps,activity,late\n";
+        CULog("Writing frame-time log to: %s", _logPath.c_str());
+    } else {
+        flushLog();
+    }
+    _logging = logging;
+}
+
+void FrameGovernor::flushLog() {
+    if (_logBuffer.empty()) {
+        return;
+    }
+    std::ofstream file(_logPath, std::ios::app);
+    if (file.is_open()) {
+        file << _logBuffer;
+    }
+    _logBuffer.clear();
+}
@@ -0,0 +1,141 @@
+//
+//  FrameGovernor.h
+//  PolarPairs
+//
+
+#ifndef __FRAME_GOVERNOR_H__
+#define __FRAME_GOVERNOR_H__
+
+#include <cugl/cugl.h>
+#include <string>
+
+/**
+ * Picks the application tick rate from what is happening on screen.
+ *
+ * Movement, slides and transitions run at the highest rate, the screen drops
+ * to a middle rate while it waits for a swipe and to the lowest rate once it
+ * has gone still. Frame times are kept in a short history; when the device
+ * keeps missing the target the governor caps itself at the next lower rate,
+ * and it probes the higher rate again after a stable stretch.
+ *
+ * The rate never drops and the cap never moves while something is moving,
+ * so movement interpolation sees a steady timestep.
+ */
+class FrameGovernor {
+public:
+    /** What the app did this frame, from the most to the least demanding */
+    enum class Activity {
+        NONE,       // Nothing changed
+        ANIMATING,  // Input, effects or menu fades
+        MOVING      // Character movement, slides or scene transitions
+    };
+
+    /** Tick rates the governor chooses between, highest first */
+    static constexpr float RATES[] = { 60.0f, 30.0f, 15.0f };
+    static constexpr int RATE_COUNT = 3;
+
+    /** Seconds after the last activity before dropping to the waiting rate */
+    static constexpr float ACTIVE_HOLD = 0.5f;
+
+    /** Seconds after the last activity before going idle at the lowest rate */
+    static constexpr float IDLE_DELAY = 2.0f;
+
+    /** A frame is late if it takes this much longer than the target interval */
+    static constexpr float LATE_TOLERANCE = 1.25f;
+
+    /** Late frames within the history window that lower the rate cap */
+    static constexpr int LATE_LIMIT = 8;
+
+    /** Seconds without late frames before trying the next higher cap */
+    static constexpr float PROBE_DELAY = 10.0f;
+
+private:
+    /** Frames kept in the history window */
+    static constexpr int HISTORY_SIZE = 30;
+
+    /** Recent frame times in seconds, as a ring buffer */
+    float _history[HISTORY_SIZE];
+    /** Recent late-frame flags, parallel to _history */
+    bool _late[HISTORY_SIZE];
+    int _historyNext;
+    int _historyCount;
+    int _lateCount;
+
+    /** Index into RATES of the current target */
+    int _target;
+    /** Index into RATES of the highest rate the device has sustained */
+    int _ceiling;
+    /** Stable seconds needed before probing a higher cap; doubles after each cap drop */
+    float _probeDelay;
+
+    /** Seconds since the last frame with activity */
+    float _quietTime;
+    /** Seconds since the last late frame at the ceiling */
+    float _stableTime;
+    /** Whether the target changed last frame, so its frame time is not judged */
+    bool _justChanged;
+    /** Activity of the last frame, for the readout and log */
+    Activity _activity;
+
+    /** Total seconds since init, for the log */
+    float _clock;
+
+    /** Frame-time log, written to the save directory while enabled */
+    bool _logging;
+    std::string _logPath;
+    std::string _logBuffer;
+
+    /** Records a frame time and whether it missed the target */
+    void record(float dt);
+
+    /** Forgets the history, after the target changes */
+    void resetHistory();
+
+    /** Switches to the given rate index and applies it to the application */
+    void setTarget(int index, const char* reason);
+
+    /** Writes buffered log lines to the log file */
+    void flushLog();
+
+public:
+    FrameGovernor();
+    ~FrameGovernor() { setLogging(false); }
+
+    /** Resets the governor and applies the highest rate */
+    void init();
+
+    /**
+     * Records the last frame and updates the target rate.
+     *
+     * Returns the timestep to simulate with. The first frame after leaving
+     * a lower rate is clamped to the new interval, so a long idle frame does
+     * not turn into a jump at the start of a move.
+     */
+    float update(float dt, Activity activity);
+
+    /** Returns the current target rate in frames per second */
+    float getTargetFPS() const { return RATES[_target]; }
+
+    /** Returns the highest rate the device is currently allowed */
+    float getCeilingFPS() const { return RATES[_ceiling]; }
+
+    /** Returns true once the screen has been still long enough to go idle */
+    bool isIdle() const { return _target == RATE_COUNT - 1 && _quietTime >= IDLE_DELAY; }
+
+    /** Returns the average frame time in the history window, in seconds */
+    float getAverageFrameTime() const;
+
+    /** Returns the slowest frame time in the history window, in seconds */
+    float getWorstFrameTime() const;
+
+    /** Returns a one-line summary for the on-screen readout */
+    std::string getReadout() const;
+
+    /** Starts or stops the frame-time log (frametimes.csv in the save directory) */
+    void setLogging(bool logging);
+
+    /** Returns true if the frame-time log is being written */
+    bool isLogging() const { return _logging; }
+};
+
+#endif /* __FRAME_GOVERNOR_H__ */
@@ -0,0 +1,34 @@
+//
+//  GridDiff.cpp
+//  PolarPairs
+//
+
+#include "GridDiff.h"
+
+std::vector<GridDiff::Change> GridDiff::diff(const std::vector<std::vector<int>>& from,
+                                             const std::vector<std::vector<int>>& to, bool animated) {
+    std::vector<Change> changes;
+    if (from.size() != to.size()) {
+        return changes;
+    }
+    for (int x = 0; x < (int)from.size(); x++) {
+        if (from[x].size() != to[x].size()) {
+            return std::vector<Change>();
+        }
+        for (int y = 0; y < (int)from[x].size(); y++) {
+            int before = from[x][y];
+            int after = to[x][y];
+            if (before == after) {
+                continue;
+            }
+            Kind kind = isHidden(before) ? Kind::ADD : isHidden(after) ? Kind::REMOVE : Kind::RETYPE;
+            if (isHidden(before) && isHidden(after)) {
+                // A block becoming an invisible block draws nothing either way,
+                // but the renderer's copy of the grid still has to follow
+                kind = Kind::RETYPE;
+            }
+            changes.push_back({ x, y, before, after, kind, animated });
+        }
+    }
+    return changes;
+}
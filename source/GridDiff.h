@@ -0,0 +1,50 @@
+//
+//  GridDiff.h
+//  PolarPairs
+//
+
+#ifndef __GRID_DIFF_H__
+#define __GRID_DIFF_H__
+
+#include <vector>
+
+/**
+ * The cell changes that turn one board grid into another.
+ *
+ * Grids use the PuzzleBoard cell types, indexed [x][y]. Restart, hot-reload
+ * and level changes hand the renderer this list instead of rebuilding the
+ * board, so their cost follows the number of cells that differ rather than
+ * the size of the board.
+ */
+class GridDiff {
+public:
+    /** What a change does to the nodes drawn in a cell */
+    enum class Kind {
+        ADD,     // Nothing was drawn (block or invisible block); now something is
+        REMOVE,  // Something was drawn; now nothing is
+        RETYPE   // Something is drawn before and after, but not the same tile
+    };
+
+    /** One cell that differs between the two grids */
+    struct Change {
+        int x;
+        int y;
+        int from;
+        int to;
+        Kind kind;
+        /** Whether the renderer eases the change in rather than swapping tiles at once */
+        bool animated;
+    };
+
+    /** Returns true if a cell of this type draws nothing */
+    static bool isHidden(int cellType) { return cellType == 1 || cellType == 7; }
+
+    /**
+     * Returns the changes from one grid to another of the same size, in
+     * column order; grids of different sizes give no changes.
+     */
+    static std::vector<Change> diff(const std::vector<std::vector<int>>& from,
+                                    const std::vector<std::vector<int>>& to, bool animated);
+};
+
+#endif /* __GRID_DIFF_H__ */
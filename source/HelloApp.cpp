@@ -1,5 +1,7 @@
 #include "HelloApp.h"
 #include "LevelManager.h"
+#include "TextureAtlas.h"
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
@@ -18,15 +20,12 @@ using namespace cugl::scene2;
 #define GAME_WIDTH 576
 #define GAME_HEIGHT 1024
 
-/**
- * Helper function to play button press sound
- */
-void playButtonSound(const std::shared_ptr<cugl::AssetManager>& assets) {
-    auto buttonSound = assets->get<cugl::audio::Sound>("buttonSound");
-    if (buttonSound) {
-        cugl::audio::AudioEngine::get()->play("buttonPress", buttonSound, false, 0.8f);
-    }
-}
+// Asset groups each scene draws from. The finish art shares the interface
+// atlas with the level selector and its buttons come from the gameplay atlas.
+static const std::vector<std::string> MENU_GROUPS = { "menu" };
+static const std::vector<std::string> LEVEL_GROUPS = { "levelselect", "interface" };
+static const std::vector<std::string> GAME_GROUPS = { "gameplay", "interface" };
+static const std::vector<std::string> FINISH_GROUPS = { "gameplay", "interface" };
 
 /**
  * Calculate tile size based on display height and grid dimensions
@@ -42,9 +41,14 @@ float HelloApp::calculateTileSize() const {
  * The method called after OpenGL is initialized, but before running the application.
  */
 void HelloApp::onStartup() {
+    _startupTime = std::chrono::steady_clock::now();
     _batch = SpriteBatch::alloc();
     setClearColor(Color4::CLEAR);
     
+    // Offscreen copy of the screen, redrawn instead of the scene while idle
+    Size pixels = getDisplaySize() * Display::get()->getPixelDensity();
+    _frameCache = RenderTarget::alloc(pixels.width, pixels.height);
+    
     // Create and initialize asset manager
     _assets = AssetManager::alloc();
     _assets->attach<Texture>(TextureLoader::alloc()->getHook());
@@ -55,19 +59,29 @@ void HelloApp::onStartup() {
     cugl::audio::AudioEngine::start();
     _assets->attach<cugl::audio::Sound>(cugl::audio::SoundLoader::alloc()->getHook());
     
-    _assets->loadDirectory("json/assets.json");
-    
-    // Play background music in a loop
-    auto backgroundMusic = _assets->get<cugl::audio::Sound>("backgroundMusic");
-    if (backgroundMusic) {
-        cugl::audio::AudioEngine::get()->play("backgroundMusic", backgroundMusic, true, 0.5f);
-    }
+    // Only the boot set (loading screen) loads before the first frame. The
+    // menu groups stream in behind the loading screen; updateLoading starts
+    // the level selector groups once the menu is up.
+    _assets->loadDirectory("json/loading.json");
+    initAssetGroups();
+    _loadStage = LoadStage::MENU;
+    buildLoadingScene();
     
     // Initialize LevelManager
     if (!LevelManager::getInstance()->init(_assets)) {
         CULog("Failed to initialize LevelManager");
         return;
     }
+    startCoop();
+    startLevelWatcher();
+    
+    // The level selector is built once; remember which levels change so
+    // only their buttons and stars are rebuilt when it is shown again
+    _levelListener = LevelManager::getInstance()->addListener([=](int level) {
+        if (std::find(_changedLevels.begin(), _changedLevels.end(), level) == _changedLevels.end()) {
+            _changedLevels.push_back(level);
+        }
+    });
     
     // Create UI fade overlay
     auto node = SceneNode::allocWithBounds(getDisplaySize());
@@ -77,6 +91,32 @@ void HelloApp::onStartup() {
         _uiFadeOverlay->setPriority(1000); // Highest priority to be on top
     }
     
+    // Frame-rate readout, toggled with F or a three-finger tap
+    _statsScene = Scene2::allocWithHint(getDisplaySize());
+    _statsScene->setSpriteBatch(_batch);
+    if (auto font = _assets->get<Font>("debug")) {
+        _statsLabel = Label::allocWithText(_governor.getReadout(), font);
+        _statsLabel->setAnchor(Vec2::ANCHOR_TOP_LEFT);
+        _statsLabel->setPosition(8, _statsScene->getSize().height - 8);
+        _statsLabel->setForeground(Color4::WHITE);
+        _statsScene->addChild(_statsLabel);
+        
+        _assetsLabel = Label::allocWithText(_residency.getReport(), font);
+        _assetsLabel->setAnchor(Vec2::ANCHOR_TOP_LEFT);
+        _assetsLabel->setPosition(8, _statsLabel->getPosition().y - _statsLabel->getHeight() - 4);
+        _assetsLabel->setForeground(Color4::WHITE);
+        _statsScene->addChild(_assetsLabel);
+        
+        _latencyLabel = Label::allocWithText(_latency.getReadout(), font);
+        _latencyLabel->setAnchor(Vec2::ANCHOR_TOP_LEFT);
+        _latencyLabel->setPosition(8, _assetsLabel->getPosition().y - _assetsLabel->getHeight() - 4);
+        _latencyLabel->setForeground(Color4::WHITE);
+        _statsScene->addChild(_latencyLabel);
+    }
+    _governor.init();
+    _spanCpu = std::clock();
+    _spanStart = std::chrono::steady_clock::now();
+    
     // Initialize selected level
     _selectedLevel = 1;
     
@@ -86,9 +126,11 @@ void HelloApp::onStartup() {
     #if defined(CU_PLATFORM_IOS) || defined(CU_PLATFORM_ANDROID)
     Input::activate<Touchscreen>();
     #endif
+    _latency.start();
     
     // Initialize animation variables
     _animTime = 0.0f;
+    _ambientTime = 0.0f;
     _sealBaseY = 0.0f;
     _bearBaseY = 0.0f;
     _sealImage = nullptr;
@@ -106,16 +148,18 @@ void HelloApp::onStartup() {
     _finishScene = Scene2::allocWithHint(getDisplaySize());
     _finishScene->setSpriteBatch(_batch);
     
-    // Create the backgrounds
-    createSharedBackground();
+    // Everything above each scene's background goes in one layer, so a fade
+    // is a single color change that the children inherit when drawn
+    _menuLayer = createFadeLayer(_menuScene);
+    _levelLayer = createFadeLayer(_levelScene);
+    _finishLayer = createFadeLayer(_finishScene);
     
-    // Build the scenes
-    buildMenuScene();
-    buildLevelScene();
-    buildFinishScene();
+    // The menu, level and finish scenes are built by updateLoading as their
+    // assets arrive
     
-    // The game controller will be created when needed during transition
-    _PolarPairsController = nullptr;
+    // The game controller is created on the first level and kept until its assets are evicted
+    _inGameScene = false;
+    _gameController = nullptr;
     
     // Start in menu scene
     _inMenuScene = true;
@@ -133,6 +177,15 @@ void HelloApp::onShutdown() {
     // Stop the audio engine
     cugl::audio::AudioEngine::stop();
     
+    if (_coopTransport) {
+        _coopTransport->close();
+    }
+    _levelWatcher.stop();
+    
+    LevelManager::getInstance()->removeListener(_levelListener);
+    LevelManager::getInstance()->shutdown();
+    releaseLevelScene();
+    
     // Clean up menu elements
     if (_logo && _logo->getParent()) {
         _logo->getParent()->removeChild(_logo);
@@ -146,9 +199,6 @@ void HelloApp::onShutdown() {
     if (_bearImage && _bearImage->getParent()) {
         _bearImage->getParent()->removeChild(_bearImage);
     }
-    if (_level1Button && _level1Button->getParent()) {
-        _level1Button->getParent()->removeChild(_level1Button);
-    }
     if (_finishExitButton && _finishExitButton->getParent()) {
         _finishExitButton->getParent()->removeChild(_finishExitButton);
     }
@@ -175,7 +225,6 @@ void HelloApp::onShutdown() {
     
     _logo = nullptr;
     _startButton = nullptr;
-    _level1Button = nullptr;
     _sealImage = nullptr;
     _bearImage = nullptr;
     _menuBackground = nullptr;
@@ -188,10 +237,27 @@ void HelloApp::onShutdown() {
     _finishStarRating = nullptr;
     _levelFinishedText = nullptr;
     _highestText = nullptr;
-    _PolarPairsController = nullptr;
+    _inGameScene = false;
+    _gameController = nullptr;
+    _menuLayer = nullptr;
+    _levelLayer = nullptr;
+    _finishLayer = nullptr;
     _menuScene = nullptr;
     _levelScene = nullptr;
     _finishScene = nullptr;
+    _loadingScene = nullptr;
+    _loadingBar = nullptr;
+    _frameCache = nullptr;
+    _governor.setLogging(false);
+    _latency.stop();
+    _statsLabel = nullptr;
+    _assetsLabel = nullptr;
+    _latencyLabel = nullptr;
+    _sounds.dispose();
+    _heldGroups.clear();
+    _nextGroups.clear();
+    _residency.dispose();
+    _statsScene = nullptr;
     _batch = nullptr;
     _assets = nullptr;
     
@@ -211,57 +277,84 @@ void HelloApp::update(float timestep) {
     // Update animations using the same timer
     _animTime += timestep;
     
+    // Let the governor pick the tick rate from what is changing this frame
+    FrameGovernor::Activity activity = getActivity();
+    timestep = _governor.update(timestep, activity);
+    updateIdleState(activity);
+    updateStats(timestep);
+    
+    // Finish asynchronous group loads and evict unused groups over budget
+    _residency.update();
+    dropEvictedScenes();
+    _sounds.update(timestep);
+    
+    // Nothing else runs until the menu assets are in
+    if (_loadStage != LoadStage::DONE) {
+        updateLoading();
+        if (_loadStage == LoadStage::MENU) {
+            return;
+        }
+    }
+    
     // Update transition if active
     if (_isTransitioning) {
         updateTransition(timestep);
         return; // Don't process input during transition
     }
     
-    // Update background animations regardless of scene
-    float amplitude = getDisplaySize().height * 0.02f; // 2% of screen height
-    float offsetY = amplitude * std::cos(_animTime * M_PI / 2.0f);
-    float offsetX = amplitude * std::sin(_animTime * M_PI / 2.0f);
-    
-    // Always update menu background position if it exists
-    if (_menuBackground) {
-        _menuBackground->setPosition(_backgroundBaseX + offsetX, _backgroundBaseY + offsetY);
-    }
-    
-    // Always update level background position if it exists
-    if (_levelBackground) {
-        _levelBackground->setPosition(_backgroundBaseX + offsetX, _backgroundBaseY + offsetY);
-    }
-    
-    // Always update game background position if it exists
-    if (_gameBackground) {
-        _gameBackground->setPosition(_backgroundBaseX + offsetX, _backgroundBaseY + offsetY);
-    }
-    
-    // Always update finish background position if it exists
-    if (_finishBackground) {
-        _finishBackground->setPosition(_backgroundBaseX + offsetX, _backgroundBaseY + offsetY);
-    }
-    
-    // Update character animations for menu scene
-    if (_sealImage) {
-        float offset = getDisplaySize().height * 0.01f * cosf(_animTime * 1.5f);
-        _sealImage->setPosition(_sealImage->getPositionX(), _sealBaseY + offset);
-    }
-    
-    if (_bearImage) {
-        float offset = getDisplaySize().height * 0.01f * cosf((_animTime - 0.5f) * 1.5f);
-        _bearImage->setPosition(_bearImage->getPositionX(), _bearBaseY + offset);
+    // Ambient animations hold still while idle so the cached frame stays valid
+    if (!_isIdle) {
+        _ambientTime += timestep;
+        
+        // Update background animations regardless of scene
+        float amplitude = getDisplaySize().height * 0.02f; // 2% of screen height
+        float offsetY = amplitude * std::cos(_ambientTime * M_PI / 2.0f);
+        float offsetX = amplitude * std::sin(_ambientTime * M_PI / 2.0f);
+        
+        // Always update menu background position if it exists
+        if (_menuBackground) {
+            _menuBackground->setPosition(_backgroundBaseX + offsetX, _backgroundBaseY + offsetY);
+        }
+        
+        // Always update level background position if it exists
+        if (_levelBackground) {
+            _levelBackground->setPosition(_backgroundBaseX + offsetX, _backgroundBaseY + offsetY);
+        }
+        
+        // Always update game background position if it exists
+        if (_gameBackground) {
+            _gameBackground->setPosition(_backgroundBaseX + offsetX, _backgroundBaseY + offsetY);
+        }
+        
+        // Always update finish background position if it exists
+        if (_finishBackground) {
+            _finishBackground->setPosition(_backgroundBaseX + offsetX, _backgroundBaseY + offsetY);
+        }
+        
+        // Update character animations for menu scene
+        if (_sealImage) {
+            float offset = getDisplaySize().height * 0.01f * cosf(_ambientTime * 1.5f);
+            _sealImage->setPosition(_sealImage->getPositionX(), _sealBaseY + offset);
+        }
+        
+        if (_bearImage) {
+            float offset = getDisplaySize().height * 0.01f * cosf((_ambientTime - 0.5f) * 1.5f);
+            _bearImage->setPosition(_bearImage->getPositionX(), _bearBaseY + offset);
+        }
+        
+        // Update level scene characters
+        if (_inLevelScene) {
+            for (auto& child : _levelLayer->getChildren()) {
+                if (child->getName() == "bearseal") {
+                    float offset = getDisplaySize().height * 0.01f * cosf(_ambientTime * 1.5f);
+                    child->setPosition(child->getPositionX(), _levelBearBaseY + offset);
+                }
+            }
+        }
     }
     
-    // Update level scene characters
+    // Update level scene
     if (_inLevelScene) {
-        for (auto& child : _levelScene->getChildren()) {
-            if (child->getName() == "bearseal") {
-                float offset = getDisplaySize().height * 0.01f * cosf(_animTime * 1.5f);
-                child->setPosition(child->getPositionX(), _levelBearBaseY + offset);
-            }
-        }
-        
         // Process button interactions through scene update
         _levelScene->update(timestep);
         
@@ -314,8 +407,8 @@ void HelloApp::update(float timestep) {
                             // Reset touch state
                             _levelTitleTouched = false;
                             
-                            // Rebuild level scene to reflect changes
-                            buildLevelScene();
+                            // Update the level buttons to reflect changes
+                            refreshLevelScene();
                         }
                     }
                 }
@@ -357,12 +450,30 @@ void HelloApp::update(float timestep) {
         if (keyboard && keyboard->keyPressed(KeyCode::ESCAPE)) {
             _inLevelScene = false;
             _inMenuScene = true;
-            buildMenuScene();
+            setLevelButtonsActive(false);
+            
+            // Show the sea right away; the rest of the menu waits on its assets
+            if (_menuBackground && !_menuBackground->getParent()) {
+                _menuScene->addChild(_menuBackground);
+            }
+            _menuLayer->setColor(Color4::WHITE);  // Faded out when the menu was left
+            requestGroups(MENU_GROUPS);
+            _menuPending = true;
         }
     } else if (_inMenuScene) {
+        // Build the menu once its assets are back
+        if (_menuPending) {
+            if (!_residency.isResident(_nextGroups)) {
+                return;
+            }
+            commitGroups();
+            buildMenuScene();
+            _menuPending = false;
+        }
+        
         // Update start page animations
-        if (_startButton) {
-            float alpha = 0.5f + 0.5f * (sinf(_animTime * 2.0f) + 1.0f) * 0.5f;
+        if (_startButton && !_isIdle) {
+            float alpha = 0.5f + 0.5f * (sinf(_ambientTime * 2.0f) + 1.0f) * 0.5f;
             _startButton->setColor(Color4(255, 255, 255, (int)(alpha * 255)));
         }
         
@@ -390,7 +501,12 @@ void HelloApp::update(float timestep) {
         
         if (tapped && !_buttonPressed) {
             _buttonPressed = true;
-            transitionToLevelSelector();
+            if (_loadStage == LoadStage::DONE) {
+                transitionToLevelSelector();
+            } else {
+                // Level select is still loading; updateLoading continues when it is ready
+                _startRequested = true;
+            }
         }
     } else if (_inFinishScene) {
         // Update finish scene animations
@@ -438,8 +554,8 @@ void HelloApp::update(float timestep) {
                 _finishRestartButton->setPosition(_restartButtonOrigPos.x, currentY);
             }
             
-            // Only show and animate the next button for levels 1-11, completely skip for level 12
-            if (_finishNextButton && _selectedLevel < 12) {
+            // Only show and animate the next button if there is a next level
+            if (_finishNextButton && _selectedLevel < LevelManager::getInstance()->getTotalLevels()) {
                 float startY = -getDisplaySize().height * 0.1f;
                 float targetY = _nextButtonOrigPos.y;
                 float currentY = startY + (targetY - startY) * easedProgress;
@@ -456,8 +572,8 @@ void HelloApp::update(float timestep) {
                 if (_highestText) _highestText->setPosition(_highestTextOrigPos);
                 if (_finishRestartButton) _finishRestartButton->setPosition(_restartButtonOrigPos);
                 
-                // Only position the next button for levels 1-11
-                if (_finishNextButton && _selectedLevel < 12) {
+                // Only position the next button if there is a next level
+                if (_finishNextButton && _selectedLevel < LevelManager::getInstance()->getTotalLevels()) {
                     _finishNextButton->setPosition(_nextButtonOrigPos);
                 }
             }
@@ -511,19 +627,20 @@ void HelloApp::update(float timestep) {
         if (keyboard && keyboard->keyPressed(KeyCode::ESCAPE)) {
             transitionToLevelSelector();
         }
-    } else if (_PolarPairsController) {
+    } else if (_inGameScene) {
         // Update game
-        _PolarPairsController->update(timestep);
+        updateLevelWatcher();
+        _gameController->update(timestep);
         
         // Handle transitions
-        if (_PolarPairsController->hasWon() || _PolarPairsController->shouldExitToMenu()) {
+        if (_gameController->hasWon() || _gameController->shouldExitToMenu()) {
             // Reset exit flag if it was set
-            if (_PolarPairsController->shouldExitToMenu()) {
-                _PolarPairsController->resetExitFlag();
+            if (_gameController->shouldExitToMenu()) {
+                _gameController->resetExitFlag();
             }
             
             // If player has won, go to finish scene
-            if (_PolarPairsController->hasWon()) {
+            if (_gameController->hasWon()) {
                 transitionToFinishScene();
             } else {
                 // Just exit to menu without going through finish scene
@@ -547,6 +664,11 @@ void HelloApp::updateTransition(float timestep) {
         // Fade out phase
         float progress = _transitionTime / duration;
         if (progress >= 1.0f) {
+            // Hold the faded-out frame until the next scene's assets are in
+            if (!_residency.isResident(_nextGroups)) {
+                return;
+            }
+            
             // Fade out complete, switch scenes
             _isFadingOut = false;
             _transitionTime = 0;
@@ -556,92 +678,38 @@ void HelloApp::updateTransition(float timestep) {
                 _inMenuScene = false;
                 _inLevelScene = true;
                 
-                // Remove menu elements
-                if (_logo && _logo->getParent()) {
-                    _logo->getParent()->removeChild(_logo);
-                    _logo = nullptr;
-                }
-                if (_startButton && _startButton->getParent()) {
-                    _startButton->getParent()->removeChild(_startButton);
-                    _startButton = nullptr;
-                }
-                if (_sealImage && _sealImage->getParent()) {
-                    _sealImage->getParent()->removeChild(_sealImage);
-                    _sealImage = nullptr;
-                }
-                if (_bearImage && _bearImage->getParent()) {
-                    _bearImage->getParent()->removeChild(_bearImage);
-                    _bearImage = nullptr;
-                }
+                // Remove menu elements and show the level selector
+                releaseMenuScene();
+                refreshLevelScene();
                 
-                // Reset level scene UI opacity
-                if (_levelScene) {
-                    for (auto& child : _levelScene->getChildren()) {
-                        if (child != _levelBackground) {
-                            child->setColor(Color4(255, 255, 255, 0));
-                        }
-                    }
-                }
+                // Start the level selector UI transparent
+                setFadeAlpha(0);
             } else if (_inLevelScene) {
-                // Switching from level to game
+                // Switching from level to game; the selector stays built
                 _inLevelScene = false;
+                setLevelButtonsActive(false);
                 
-                // Create a new controller
-                _PolarPairsController = std::make_shared<PolarPairsController>();
-                
-                if (_PolarPairsController->init(_assets, getDisplaySize())) {
-                    auto gameScene = _PolarPairsController->getScene();
-                    if (gameScene) {
-                        gameScene->setSpriteBatch(_batch);
-                        
-                        // Add the game background
-                        if (_gameBackground) {
-                            if (_gameBackground->getParent()) {
-                                _gameBackground->getParent()->removeChild(_gameBackground);
-                            }
-                            _gameBackground->setPosition(_backgroundBaseX, _backgroundBaseY);
-                            _gameBackground->setPriority(-200);
-                            gameScene->addChild(_gameBackground);
-                        }
-                        
-                        // Set initial opacity for game scene UI elements
-                        for (auto& child : gameScene->getChildren()) {
-                            if (child != _gameBackground) {
-                                child->setColor(Color4(255, 255, 255, 0));
-                            }
-                        }
-                        
-                        _PolarPairsController->switchLevel(_selectedLevel);
-                    } else {
-                        _inMenuScene = true;
-                        _inLevelScene = false;
-                    }
-                } else {
+                if (!startGame(_selectedLevel)) {
                     _inMenuScene = true;
                     _inLevelScene = false;
                 }
-            } else if (_PolarPairsController && !_inFinishScene) {
+            } else if (_inGameScene && !_inFinishScene) {
                 // Check if transition should go to finish scene or level selector
-                if (_PolarPairsController->hasWon()) {
+                if (_gameController->hasWon()) {
                     // Switching from game to finish scene
                     _inFinishScene = true;
                     
-                    // Clean up game scene
-                    if (_gameBackground && _gameBackground->getParent()) {
-                        _gameBackground->getParent()->removeChild(_gameBackground);
-                    }
-                    
                     // Store the level we just completed
-                    _selectedLevel = _PolarPairsController->getCurrentLevel();
+                    _selectedLevel = _gameController->getCurrentLevel();
                     
-                    // Clean up controller
-                    _PolarPairsController = nullptr;
+                    // Park the controller for the next level
+                    stopGame();
                     
                     // Update finish scene for the completed level - don't rebuild
                     // Instead, just handle the next button visibility
                     if (_finishNextButton) {
-                        if (_selectedLevel >= 12) {
-                            // Hide the next button for level 12
+                        if (_selectedLevel >= LevelManager::getInstance()->getTotalLevels()) {
+                            // Hide the next button for the last level
                             _finishNextButton->setVisible(false);
                             _finishNextButton->deactivate(); // Disable interaction
                         } else {
@@ -651,131 +719,49 @@ void HelloApp::updateTransition(float timestep) {
                         }
                     }
                     
-                    // Reset finish scene UI opacity
-                    if (_finishScene) {
-                        for (auto& child : _finishScene->getChildren()) {
-                            if (child != _finishBackground && child != _finishNextButton) {
-                                child->setColor(Color4(255, 255, 255, 0));
-                            }
-                        }
-                    }
+                    // Start the finish scene UI transparent
+                    setFadeAlpha(0);
                 } else {
                     // Switching from game to level selector
                     _inLevelScene = true;
+                    stopGame();
+                    refreshLevelScene();
                     
-                    // Clean up game scene
-                    if (_gameBackground && _gameBackground->getParent()) {
-                        _gameBackground->getParent()->removeChild(_gameBackground);
-                    }
-                    _PolarPairsController = nullptr;
-                    
-                    // Reset level scene UI opacity
-                    if (_levelScene) {
-                        for (auto& child : _levelScene->getChildren()) {
-                            if (child != _levelBackground) {
-                                child->setColor(Color4(255, 255, 255, 0));
-                            }
-                        }
-                    }
+                    // Start the level selector UI transparent
+                    setFadeAlpha(0);
                 }
             } else if (_inFinishScene) {
                 // Check if we should go to next level directly
                 if (_goToNextLevel) {
-                    // Create a new controller for the next level
+                    // Go straight to the next level with the same controller
                     _inFinishScene = false;
                     _isFinishSceneAnimating = false; // Reset animation state
+                    releaseFinishScene();
                     
-                    // Create a new controller
-                    _PolarPairsController = std::make_shared<PolarPairsController>();
-                    
-                    if (_PolarPairsController->init(_assets, getDisplaySize())) {
-                        auto gameScene = _PolarPairsController->getScene();
-                        if (gameScene) {
-                            gameScene->setSpriteBatch(_batch);
-                            
-                            // Add the game background
-                            if (_gameBackground) {
-                                if (_gameBackground->getParent()) {
-                                    _gameBackground->getParent()->removeChild(_gameBackground);
-                                }
-                                _gameBackground->setPosition(_backgroundBaseX, _backgroundBaseY);
-                                _gameBackground->setPriority(-200);
-                                gameScene->addChild(_gameBackground);
-                            }
-                            
-                            // Set initial opacity for game scene UI elements
-                            for (auto& child : gameScene->getChildren()) {
-                                if (child != _gameBackground) {
-                                    child->setColor(Color4(255, 255, 255, 0));
-                                }
-                            }
-                            
-                            // Switch to the next level
-                            _PolarPairsController->switchLevel(_selectedLevel);
-                            
-                            // Reset the flag
-                            _goToNextLevel = false;
-                        } else {
-                            // Fallback to level selector on error
-                            _inLevelScene = true;
-                            _goToNextLevel = false;
-                        }
-                    } else {
+                    if (!startGame(_selectedLevel)) {
                         // Fallback to level selector on error
                         _inLevelScene = true;
-                        _goToNextLevel = false;
                     }
+                    _goToNextLevel = false;
                 } else {
                     // Switching from finish scene to level scene
                     _inFinishScene = false;
                     _isFinishSceneAnimating = false; // Reset animation state
                     _inLevelScene = true;
+                    releaseFinishScene();
+                    refreshLevelScene();
                     
-                    // Reset level scene UI opacity
-                    if (_levelScene) {
-                        for (auto& child : _levelScene->getChildren()) {
-                            if (child != _levelBackground) {
-                                child->setColor(Color4(255, 255, 255, 0));
-                            }
-                        }
-                    }
+                    // Start the level selector UI transparent
+                    setFadeAlpha(0);
                 }
             }
+            
+            // The new scene is up; the old scene's groups may now be evicted
+            commitGroups();
         } else {
             // Update UI elements opacity
             int alpha = static_cast<int>((1.0f - progress) * 255);
-            if (_inMenuScene && _menuScene) {
-                for (auto& child : _menuScene->getChildren()) {
-                    if (child != _menuBackground) {
-                        child->setColor(Color4(255, 255, 255, alpha));
-                    }
-                }
-            } else if (_inLevelScene && _levelScene) {
-                for (auto& child : _levelScene->getChildren()) {
-                    if (child != _levelBackground) {
-                        child->setColor(Color4(255, 255, 255, alpha));
-                    }
-                }
-                
-                // Also update star rating images
-                for (auto& star : _levelStars) {
-                    star->setColor(Color4(255, 255, 255, alpha));
-                }
-            } else if (_inFinishScene && _finishScene) {
-                for (auto& child : _finishScene->getChildren()) {
-                    if (child != _finishBackground) {
-                        child->setColor(Color4(255, 255, 255, alpha));
-                    }
-                }
-            } else if (_PolarPairsController && _PolarPairsController->getScene()) {
-                // Fade out game scene UI elements
-                auto gameScene = _PolarPairsController->getScene();
-                for (auto& child : gameScene->getChildren()) {
-                    if (child != _gameBackground) {
-                        child->setColor(Color4(255, 255, 255, alpha));
-                    }
-                }
-            }
+            setFadeAlpha(alpha);
         }
     } else {
         // Fade in phase
@@ -784,101 +770,588 @@ void HelloApp::updateTransition(float timestep) {
             // Fade in complete
             _isTransitioning = false;
             _transitionTime = 0;
-            if (_inMenuScene && _menuScene) {
-                for (auto& child : _menuScene->getChildren()) {
-                    if (child != _menuBackground) {
-                        child->setColor(Color4::WHITE);
-                    }
-                }
-            } else if (_inLevelScene && _levelScene) {
-                for (auto& child : _levelScene->getChildren()) {
-                    if (child != _levelBackground) {
-                        child->setColor(Color4::WHITE);
-                    }
-                }
-                
-                // Also update star rating images
-                for (auto& star : _levelStars) {
-                    star->setColor(Color4::WHITE);
-                }
-            } else if (_inFinishScene && _finishScene) {
-                for (auto& child : _finishScene->getChildren()) {
-                    if (child != _finishBackground) {
-                        child->setColor(Color4::WHITE);
-                    }
-                }
-            } else if (_PolarPairsController && _PolarPairsController->getScene()) {
-                // Fade in game scene UI elements
-                auto gameScene = _PolarPairsController->getScene();
-                for (auto& child : gameScene->getChildren()) {
-                    if (child != _gameBackground) {
-                        child->setColor(Color4::WHITE);
-                    }
-                }
-            }
+            setFadeAlpha(255);
         } else {
             // Update UI elements opacity
             int alpha = static_cast<int>(progress * 255);
-            if (_inMenuScene && _menuScene) {
-                for (auto& child : _menuScene->getChildren()) {
-                    if (child != _menuBackground) {
-                        child->setColor(Color4(255, 255, 255, alpha));
-                    }
-                }
-            } else if (_inLevelScene && _levelScene) {
-                for (auto& child : _levelScene->getChildren()) {
-                    if (child != _levelBackground) {
-                        child->setColor(Color4(255, 255, 255, alpha));
-                    }
-                }
-                
-                // Also update star rating images
-                for (auto& star : _levelStars) {
-                    star->setColor(Color4(255, 255, 255, alpha));
-                }
-            } else if (_inFinishScene && _finishScene) {
-                for (auto& child : _finishScene->getChildren()) {
-                    if (child != _finishBackground) {
-                        child->setColor(Color4(255, 255, 255, alpha));
-                    }
-                }
-            } else if (_PolarPairsController && _PolarPairsController->getScene()) {
-                // Fade in game scene UI elements
-                auto gameScene = _PolarPairsController->getScene();
-                for (auto& child : gameScene->getChildren()) {
-                    if (child != _gameBackground) {
-                        child->setColor(Color4(255, 255, 255, alpha));
-                    }
-                }
+            setFadeAlpha(alpha);
+        }
+    }
+}
+
+bool HelloApp::startGame(int level) {
+    if (!_gameController) {
+        auto controller = std::make_shared<PolarPairsController>();
+        if (!controller->init(_assets, getDisplaySize(), _batch)) {
+            return false;
+        }
+        _gameController = controller;
+        _gameController->setInputLatency(&_latency);
+        if (_coopTransport) {
+            _gameController->setCoop(&_coop);
+        }
+        
+        // The game background stays in the background layer
+        if (_gameBackground) {
+            if (_gameBackground->getParent()) {
+                _gameBackground->getParent()->removeChild(_gameBackground);
+            }
+            _gameBackground->setPosition(_backgroundBaseX, _backgroundBaseY);
+            _gameController->getBackgroundLayer()->addChild(_gameBackground);
+        }
+    }
+    
+    _inGameScene = true;
+    _gameController->switchLevel(level);
+    if (_coopTransport) {
+        // Frames start once the other player has opened the same level
+        _coop.begin(level);
+    }
+    
+    // Start the game layers above the background transparent
+    _gameController->getForegroundLayer()->setColor(Color4(255, 255, 255, 0));
+    return true;
+}
+
+void HelloApp::stopGame() {
+    if (_inGameScene) {
+        _gameController->deactivate();
+        _inGameScene = false;
+    }
+    if (_coop.isRunning()) {
+        CULog("%s", _coop.getReport().c_str());
+    }
+    _coop.end();
+}
+
+void HelloApp::startCoop() {
+    const char* mode = std::getenv("POLARPAIRS_COOP");
+    if (!mode || !*mode) {
+        return;
+    }
+    
+    std::vector<std::string> parts;
+    std::istringstream stream(mode);
+    std::string part;
+    while (std::getline(stream, part, ':')) {
+        parts.push_back(part);
+    }
+    
+    LockstepSession::Role role = LockstepSession::Role::BEAR;
+    if (parts[0] == "udp" && parts.size() == 4) {
+        int localPort = std::atoi(parts[1].c_str());
+        int remotePort = std::atoi(parts[3].c_str());
+        auto transport = std::make_shared<UdpTransport>();
+        if (!transport->init(localPort, parts[2], remotePort)) {
+            return;
+        }
+        // With no lobby, the lower port takes the bear so both copies agree
+        role = localPort < remotePort ? LockstepSession::Role::BEAR : LockstepSession::Role::PENGUIN;
+        _coopTransport = transport;
+    } else if (parts[0] == "host" || (parts[0] == "join" && parts.size() == 2)) {
+        auto reader = JsonReader::allocWithAsset("json/coop.json");
+        std::shared_ptr<JsonValue> config = reader ? reader->readJson() : nullptr;
+        if (!config) {
+            CULog("Co-op: could not read json/coop.json");
+            return;
+        }
+        std::string room = parts[0] == "join" ? parts[1] : "";
+        auto transport = std::make_shared<NetcodeTransport>();
+        if (!transport->init(config, room)) {
+            return;
+        }
+        role = room.empty() ? LockstepSession::Role::BEAR : LockstepSession::Role::PENGUIN;
+        _coopTransport = transport;
+    } else {
+        CULog("Co-op: POLARPAIRS_COOP should be host, join:<room> or udp:<port>:<host>:<port>");
+        return;
+    }
+    
+    _coop.init(_coopTransport.get(), role);
+    CULog("Co-op: playing the %s", role == LockstepSession::Role::BEAR ? "bear" : "penguin");
+}
+
+void HelloApp::startLevelWatcher() {
+#ifndef NDEBUG
+    const char* dir = std::getenv("POLARPAIRS_LEVEL_DIR");
+    std::string directory = dir && *dir ? dir : getAssetDirectory() + "levels/";
+    if (directory.back() != '/') {
+        directory += '/';
+    }
+    if (!_levelWatcher.start(directory)) {
+        return;
+    }
+    // Levels loaded later come from the watched files too
+    LevelData::levelDirectory() = directory;
+    CULog("Watching %s for level edits", directory.c_str());
+#endif
+}
+
+void HelloApp::updateLevelWatcher() {
+    if (!_levelWatcher.isWatching()) {
+        return;
+    }
+    int current = _gameController->getCurrentLevel();
+    for (int level : _levelWatcher.poll()) {
+        if (level != current) {
+            continue;
+        }
+        // Editors may save a half-written file first; the next save reloads it
+        LevelData data;
+        if (LevelData::loadFile(data, _levelWatcher.getDirectory() + "level" + std::to_string(level) + ".txt")) {
+            _gameController->reloadLevel(data);
+        } else {
+            CULog("Could not read edited level %d", level);
+        }
+    }
+}
+
+std::shared_ptr<cugl::scene2::SceneNode> HelloApp::createFadeLayer(const std::shared_ptr<cugl::scene2::Scene2>& scene) {
+    auto layer = SceneNode::allocWithBounds(scene->getSize());
+    layer->setName("ui");
+    scene->addChild(layer);
+    return layer;
+}
+
+std::shared_ptr<cugl::scene2::SceneNode> HelloApp::getFadeLayer() const {
+    if (_inMenuScene) {
+        return _menuLayer;
+    } else if (_inLevelScene) {
+        return _levelLayer;
+    } else if (_inFinishScene) {
+        return _finishLayer;
+    } else if (_inGameScene) {
+        return _gameController->getForegroundLayer();
+    }
+    return nullptr;
+}
+
+void HelloApp::setFadeAlpha(int alpha) {
+    auto layer = getFadeLayer();
+    if (layer) {
+        layer->setColor(Color4(255, 255, 255, alpha));
+    }
+}
+
+bool HelloApp::hasInputActivity() const {
+    auto touch = Input::get<Touchscreen>();
+    if (touch && touch->touchCount() > 0) {
+        return true;
+    }
+    
+    auto mouse = Input::get<Mouse>();
+    if (mouse && mouse->buttonDown().hasLeft()) {
+        return true;
+    }
+    
+    auto keyboard = Input::get<Keyboard>();
+    return keyboard && keyboard->keyCount() > 0;
+}
+
+float HelloApp::millisSinceStartup() const {
+    auto elapsed = std::chrono::steady_clock::now() - _startupTime;
+    return std::chrono::duration<float, std::milli>(elapsed).count();
+}
+
+void HelloApp::buildLoadingScene() {
+    Size displaySize = getDisplaySize();
+    _loadingScene = Scene2::allocWithHint(displaySize);
+    _loadingScene->setSpriteBatch(_batch);
+    
+    // Solid sea-blue backdrop; the sea texture itself is in the menu stage
+    auto backdrop = PolygonNode::allocWithPoly(Rect(0, 0, displaySize.width, displaySize.height));
+    backdrop->setColor(Color4(36, 110, 170, 255));
+    _loadingScene->addChild(backdrop);
+    
+    if (auto logoTexture = _assets->get<Texture>("logo")) {
+        auto logo = PolygonNode::allocWithTexture(logoTexture);
+        logo->setScale(displaySize.width * 0.6f / logoTexture->getWidth());
+        logo->setAnchor(Vec2::ANCHOR_CENTER);
+        logo->setPosition(displaySize.width / 2.0f, displaySize.height * 0.55f);
+        _loadingScene->addChild(logo);
+    }
+    
+    // Progress bar: a dark track with a white fill that grows from the left
+    float barWidth = displaySize.width * 0.6f;
+    float barHeight = displaySize.height * 0.012f;
+    float barX = (displaySize.width - barWidth) / 2.0f;
+    float barY = displaySize.height * 0.35f;
+    
+    auto track = PolygonNode::allocWithPoly(Rect(0, 0, barWidth, barHeight));
+    track->setColor(Color4(0, 0, 0, 96));
+    track->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    track->setPosition(barX, barY);
+    _loadingScene->addChild(track);
+    
+    _loadingBar = PolygonNode::allocWithPoly(Rect(0, 0, barWidth, barHeight));
+    _loadingBar->setColor(Color4::WHITE);
+    _loadingBar->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    _loadingBar->setPosition(barX, barY);
+    _loadingBar->setScale(Vec2(0.0f, 1.0f));
+    _loadingScene->addChild(_loadingBar);
+}
+
+void HelloApp::updateLoading() {
+    if (_loadStage == LoadStage::MENU) {
+        if (_loadingBar) {
+            _loadingBar->setScale(Vec2(_assets->progress(), 1.0f));
+        }
+        if (!_residency.isResident("common") || !_residency.isResident(_nextGroups)) {
+            return;
+        }
+        
+        // Menu assets are in: build the menu and start the music
+        commitGroups();
+        _sounds.init(_assets, "app.");
+        createSharedBackground();
+        buildMenuScene();
+        // The music streams through the engine's music queue, which decodes a
+        // page at a time on the audio thread; only the short effects are
+        // decoded into memory
+        auto backgroundMusic = _assets->get<cugl::audio::Sound>("backgroundMusic");
+        if (backgroundMusic) {
+            cugl::audio::AudioEngine::get()->getMusicQueue()->play(backgroundMusic, true, 0.5f);
+        }
+        CULog("Audio memory: %zu KB decoded effects, music streamed (%zu KB if decoded)",
+              _residency.getSoundBytes(false) / 1024, _residency.getSoundBytes(true) / 1024);
+        _loadingScene = nullptr;
+        _loadingBar = nullptr;
+        CULog("Time to interactive: %.0f ms", millisSinceStartup());
+        
+        // Stream the level selector while the player is on the menu; the
+        // gameplay groups load when a level is picked
+        _loadStage = LoadStage::BACKGROUND;
+        requestGroups(LEVEL_GROUPS);
+    } else if (_loadStage == LoadStage::BACKGROUND) {
+        if (!_residency.isResident(_nextGroups)) {
+            return;
+        }
+        
+        _loadStage = LoadStage::DONE;
+        CULog("Level selector assets loaded: %.0f ms", millisSinceStartup());
+        
+        if (_startRequested) {
+            _startRequested = false;
+            transitionToLevelSelector();
+        }
+    }
+}
+
+void HelloApp::initAssetGroups() {
+    // Low-memory Android devices get a tighter budget for unused scene assets
+    #if defined(CU_PLATFORM_ANDROID)
+    _residency.init(_assets, 32 * 1024 * 1024);
+    #else
+    _residency.init(_assets);
+    #endif
+    
+    // Load the smallest texture variants that still cover a tile on this display
+    _variants.init(calculateTileSize() * Display::get()->getPixelDensity());
+    
+    // Boot and shared assets (sea background, button sound, music) stay loaded
+    _residency.addGroup("boot", { "json/loading.json" }, true);
+    _residency.addGroup("common", { _variants.getFile("json/common.json") }, true);
+    _residency.addGroup("menu", { _variants.getFile("json/menu.json") });
+    _residency.addGroup("levelselect", { _variants.getFile("json/levelselect.json"),
+                                         _variants.getFile(TextureAtlas::getFile("levelbuttons")) });
+    _residency.addGroup("interface", { _variants.getFile(TextureAtlas::getFile("interface")) });
+    _residency.addGroup("gameplay", { _variants.getFile("json/gameplay.json"),
+                                      _variants.getFile(TextureAtlas::getFile("gameplay")) });
+    
+    _residency.acquire("common");
+    requestGroups(MENU_GROUPS);
+}
+
+void HelloApp::requestGroups(const std::vector<std::string>& groups) {
+    // Acquire first so groups shared with a pending request are never dropped
+    for (const std::string& group : groups) {
+        _residency.acquire(group);
+    }
+    for (const std::string& group : _nextGroups) {
+        _residency.release(group);
+    }
+    _nextGroups = groups;
+}
+
+void HelloApp::commitGroups() {
+    for (const std::string& group : _heldGroups) {
+        _residency.release(group);
+    }
+    _heldGroups = _nextGroups;
+    _nextGroups.clear();
+    CULog("%s", _residency.getReport().c_str());
+}
+
+void HelloApp::dropEvictedScenes() {
+    // Kept scenes hold their groups only while on screen (or being switched
+    // to). Once one of their groups is evicted, drop their nodes so the
+    // textures are freed; they are rebuilt on the next visit.
+    if (!_inLevelScene && !_levelButtons.empty() && !_residency.isResident(LEVEL_GROUPS)) {
+        releaseLevelScene();
+    }
+    if (!_inGameScene && _gameController && !_residency.isResident(GAME_GROUPS)) {
+        // The shared background outlives the controller; startGame parents it again
+        if (_gameBackground && _gameBackground->getParent()) {
+            _gameBackground->removeFromParent();
+        }
+        _gameController = nullptr;
+    }
+}
+
+void HelloApp::releaseMenuScene() {
+    _logo = nullptr;
+    _startButton = nullptr;
+    _sealImage = nullptr;
+    _bearImage = nullptr;
+    if (_menuLayer) {
+        _menuLayer->removeAllChildren();
+    }
+}
+
+void HelloApp::releaseLevelScene() {
+    if (_levelButtons.empty()) {
+        return;
+    }
+    setLevelButtonsActive(false);
+    _levelButtons.clear();
+    _levelStars.clear();
+    _levelTitle = nullptr;
+    _levelTitleTouched = false;
+    if (_levelLayer) {
+        _levelLayer->removeAllChildren();
+    }
+}
+
+void HelloApp::releaseFinishScene() {
+    if (_finishExitButton) {
+        _finishExitButton->deactivate();
+    }
+    if (_finishRestartButton) {
+        _finishRestartButton->deactivate();
+    }
+    if (_finishNextButton) {
+        _finishNextButton->deactivate();
+    }
+    _finishExitButton = nullptr;
+    _finishRestartButton = nullptr;
+    _finishNextButton = nullptr;
+    _finishStarRating = nullptr;
+    _levelFinishedText = nullptr;
+    _highestText = nullptr;
+    if (_finishLayer) {
+        _finishLayer->removeAllChildren();
+    }
+}
+
+void HelloApp::refreshLevelScene() {
+    if (_levelButtons.empty()) {
+        buildLevelScene();
+        _changedLevels.clear();
+        setLevelButtonsActive(true);
+        return;
+    }
+    
+    // Swap in new nodes for the levels that changed; the rest are untouched
+    for (int level : _changedLevels) {
+        size_t index = level - 1;
+        if (level <= 0 || index >= _levelButtons.size() || !_levelButtons[index]) {
+            continue;
+        }
+        auto oldButton = _levelButtons[index];
+        Vec2 position = oldButton->getPosition();
+        
+        auto button = createLevelButton(level, position, _levelButtonSize);
+        if (button) {
+            oldButton->deactivate();
+            _levelLayer->removeChild(oldButton);
+            _levelLayer->addChild(button);
+            _levelButtons[index] = button;
+        }
+        
+        auto star = createLevelStar(level, position, _levelButtonSize);
+        if (star) {
+            if (_levelStars[index]) {
+                _levelLayer->removeChild(_levelStars[index]);
+            }
+            _levelLayer->addChild(star);
+            _levelStars[index] = star;
+        }
+    }
+    if (!_changedLevels.empty()) {
+        CULog("Level selector updated %zu level(s)", _changedLevels.size());
+        _changedLevels.clear();
+    }
+    setLevelButtonsActive(true);
+}
+
+void HelloApp::setLevelButtonsActive(bool active) {
+    for (auto& button : _levelButtons) {
+        if (!button || button->isActive() == active) {
+            continue;
+        }
+        if (active) {
+            button->activate();
+        } else {
+            button->deactivate();
+            button->setDown(false);
+        }
+    }
+    if (!active) {
+        _levelTitleTouched = false;
+    }
+}
+
+FrameGovernor::Activity HelloApp::getActivity() const {
+    // The loading screen progress bar moves every frame
+    if (_loadStage == LoadStage::MENU) {
+        return FrameGovernor::Activity::ANIMATING;
+    }
+    
+    // Motion needs a steady rate until it finishes
+    if (_isTransitioning || _isFinishSceneAnimating ||
+        (_inGameScene && _gameController->isMoving())) {
+        return FrameGovernor::Activity::MOVING;
+    }
+    
+    if (hasInputActivity() || (_inGameScene && _gameController->isAnimating())) {
+        return FrameGovernor::Activity::ANIMATING;
+    }
+    return FrameGovernor::Activity::NONE;
+}
+
+void HelloApp::updateIdleState(FrameGovernor::Activity activity) {
+    if (activity != FrameGovernor::Activity::NONE) {
+        _frameCacheValid = false;
+    }
+    
+    bool idle = _governor.isIdle();
+    if (idle && !_isIdle) {
+        logCpuSpan("Active");
+        _skippedRenders = 0;
+    } else if (!idle && _isIdle) {
+        logCpuSpan("Idle");
+        CULog("Leaving idle mode, %d scene renders skipped", _skippedRenders);
+    }
+    _isIdle = idle;
+}
+
+void HelloApp::logCpuSpan(const char* what) {
+    std::clock_t cpu = std::clock();
+    auto now = std::chrono::steady_clock::now();
+#if !defined(_MSC_VER)
+    // The active span ends with IDLE_DELAY of quiet frames on the same screen,
+    // so comparing it with the idle span that follows shows what idle mode saves.
+    // (MSVC's clock() is wall time, so Windows builds do not report this.)
+    double wall = std::chrono::duration<double>(now - _spanStart).count();
+    if (wall > 0) {
+        double used = double(cpu - _spanCpu) / CLOCKS_PER_SEC;
+        CULog("%s for %.1f s, process CPU %.1f%% of one core", what, wall, 100.0 * used / wall);
+    }
+#endif
+    _spanCpu = cpu;
+    _spanStart = now;
+}
+
+void HelloApp::updateStats(float timestep) {
+    bool toggle = false;
+    auto keyboard = Input::get<Keyboard>();
+    if (keyboard && keyboard->keyPressed(KeyCode::F)) {
+        toggle = true;
+    }
+    auto touch = Input::get<Touchscreen>();
+    bool threeFingers = touch && touch->touchCount() >= 3;
+    if (threeFingers && !_statsTouchHeld) {
+        toggle = true;
+    }
+    _statsTouchHeld = threeFingers;
+    
+    if (toggle) {
+        _showStats = !_showStats;
+        _governor.setLogging(_showStats);
+        _latency.setLogging(_showStats);
+        _statsTime = 0.25f; // Refresh right away
+    }
+    
+    // Refresh the text a few times a second so it stays readable
+    if (_showStats && _statsLabel) {
+        _statsTime += timestep;
+        if (_statsTime >= 0.25f) {
+            _statsTime = 0;
+            _statsLabel->setText(_governor.getReadout(), true);
+            if (_assetsLabel) {
+                _assetsLabel->setText(_residency.getReport(), true);
+            }
+            if (_latencyLabel) {
+                _latencyLabel->setText(_latency.getReadout(), true);
             }
         }
     }
 }
 
+std::shared_ptr<cugl::scene2::Scene2> HelloApp::getActiveScene() const {
+    if (_loadingScene) {
+        return _loadingScene;
+    } else if (_inMenuScene) {
+        return _menuScene;
+    } else if (_inLevelScene) {
+        return _levelScene;
+    } else if (_inFinishScene) {
+        return _finishScene;
+    } else if (_inGameScene && _gameController->getScene()) {
+        return _gameController->getScene();
+    }
+    return _menuScene;
+}
+
 /**
  * Draw the application to the screen
  */
 void HelloApp::draw() {
-    if (_inMenuScene) {
-        _menuScene->render();
-    } else if (_inLevelScene) {
-        _levelScene->render();
-    } else if (_inFinishScene) {
-        _finishScene->render();
-    } else if (_PolarPairsController && _PolarPairsController->getScene()) {
-        auto gameScene = _PolarPairsController->getScene();
-        if (!gameScene->getSpriteBatch()) {
-            gameScene->setSpriteBatch(_batch);
+    if (!_firstFrameDrawn) {
+        _firstFrameDrawn = true;
+        CULog("Time to first frame: %.0f ms", millisSinceStartup());
+    }
+    
+    auto scene = getActiveScene();
+    if (!scene->getSpriteBatch()) {
+        scene->setSpriteBatch(_batch);
+    }
+    
+    // While idle the screen does not change: render the scene once into the
+    // frame cache and redraw that single texture on every later frame
+    if (_isIdle && _frameCache) {
+        if (!_frameCacheValid) {
+            _frameCache->begin();
+            scene->render();
+            _frameCache->end();
+            _frameCacheValid = true;
+        } else {
+            _skippedRenders++;
         }
-        gameScene->render();
+        
+        // Framebuffer textures are stored bottom row first, so flip them back
+        auto texture = _frameCache->getTexture();
+        Size size = scene->getSize();
+        Affine2 flip(size.width / texture->getWidth(), 0, 0, -size.height / texture->getHeight(), 0, size.height);
+        _batch->begin(scene->getCamera()->getCombined());
+        _batch->draw(texture, Vec2::ZERO, flip);
+        _batch->end();
     } else {
-        _menuScene->render();
+        scene->render();
+        
+        // Always render UI fade overlay if transitioning
+        if (_isTransitioning && _uiFadeOverlay) {
+            _uiFadeOverlay->render(_batch);
+        }
     }
     
-    // Always render UI fade overlay if transitioning
-    if (_isTransitioning && _uiFadeOverlay) {
-        _uiFadeOverlay->render(_batch);
+    // The readout sits over everything, including the cached frame
+    if (_showStats && _statsScene) {
+        _statsScene->render();
     }
+    
+    // The frame is complete; CUGL presents it when draw returns
+    _latency.markPresented();
 }
 
 std::shared_ptr<cugl::scene2::PolygonNode> HelloApp::createCharacter(const std::string& textureName, 
@@ -923,7 +1396,7 @@ void HelloApp::buildMenuScene() {
     float effectiveHeight = displaySize.height - topSafeArea - bottomSafeArea;
     
     // Add background to menu scene
-    if (_menuBackground) {
+    if (_menuBackground && !_menuBackground->getParent()) {
         _menuScene->addChild(_menuBackground);
     }
     
@@ -938,7 +1411,7 @@ void HelloApp::buildMenuScene() {
         topLogo->setAnchor(Vec2::ANCHOR_CENTER);
         topLogo->setPosition(displaySize.width *0.2f, displaySize.height * 0.1f);
         topLogo->setPriority(200); // Set priority to be above characters
-        _menuScene->addChild(topLogo);
+        _menuLayer->addChild(topLogo);
     }
     
     // Create characters using tileSize as reference
@@ -952,7 +1425,7 @@ void HelloApp::buildMenuScene() {
                                 bearScale,
                                 "bear",
                                 _bearBaseY);
-    if (_bearImage) _menuScene->addChild(_bearImage);
+    if (_bearImage) _menuLayer->addChild(_bearImage);
     
     _sealImage = createCharacter("SealTitleIMG",
                                 displaySize.width * 0.25f,
@@ -960,7 +1433,7 @@ void HelloApp::buildMenuScene() {
                                 sealScale,
                                 "seal",
                                 _sealBaseY);
-    if (_sealImage) _menuScene->addChild(_sealImage);
+    if (_sealImage) _menuLayer->addChild(_sealImage);
     
     // Add title - PolarPairsTextTitle should be 1x of tileSize height
     if (auto titleTexture = _assets->get<Texture>("PolarPairsTextTitle")) {
@@ -970,7 +1443,7 @@ void HelloApp::buildMenuScene() {
         _logo->setAnchor(Vec2::ANCHOR_CENTER);
         _logo->setPosition(displaySize.width / 2.0f, displaySize.height / 1.9f);
         _logo->setPriority(200); // Set priority to be above characters
-        _menuScene->addChild(_logo);
+        _menuLayer->addChild(_logo);
     }
     
     // Add start button - TapToStart should be 0.7x of tileSize height
@@ -982,7 +1455,7 @@ void HelloApp::buildMenuScene() {
         _startButton->setPosition(displaySize.width / 2.0f, bottomSafeArea + effectiveHeight * 0.32f);
         _startButton->setPriority(300); // Set priority to be above everything
         _startButton->setColor(Color4(255, 255, 255, 128));
-        _menuScene->addChild(_startButton);
+        _menuLayer->addChild(_startButton);
     }
 }
 
@@ -1052,8 +1525,8 @@ std::shared_ptr<cugl::scene2::Button> HelloApp::createLevelButton(int level, con
     std::string upTextureName = isUnlocked ? "Level" + std::to_string(level) + "_Up" : "Level" + std::to_string(level) + "_Down";
     std::string downTextureName = "Level" + std::to_string(level) + "_Down";
     
-    std::shared_ptr<Texture> upTexture = _assets->get<Texture>(upTextureName);
-    std::shared_ptr<Texture> downTexture = _assets->get<Texture>(downTextureName);
+    std::shared_ptr<Texture> upTexture = TextureAtlas::get(_assets, upTextureName);
+    std::shared_ptr<Texture> downTexture = TextureAtlas::get(_assets, downTextureName);
     
     if (!upTexture || !downTexture) {
         return nullptr;
@@ -1075,7 +1548,7 @@ std::shared_ptr<cugl::scene2::Button> HelloApp::createLevelButton(int level, con
     button->addListener([=] (const std::string& name, bool down) {
         if (down) {
             // Play button sound on press
-            playButtonSound(_assets);
+            _sounds.play(SoundEvents::Event::BUTTON);
         } else if (!down && isUnlocked) {
             _selectedLevel = level;
             transitionToGame(level);
@@ -1085,11 +1558,45 @@ std::shared_ptr<cugl::scene2::Button> HelloApp::createLevelButton(int level, con
     return button;
 }
 
+std::shared_ptr<cugl::scene2::PolygonNode> HelloApp::createLevelStar(int level, const cugl::Vec2& position, float buttonSize) {
+    // Get level score (0-3)
+    int score = LevelManager::getInstance()->getLevelScore(level);
+    
+    // Add star rating based on score (0-3)
+    std::string starTextureName;
+    switch (score) {
+        case 1: starTextureName = "OneStar"; break;
+        case 2: starTextureName = "TwoStars"; break;
+        case 3: starTextureName = "ThreeStars"; break;
+        default: starTextureName = "NoStar"; break;
+    }
+    
+    auto starTexture = TextureAtlas::get(_assets, starTextureName);
+    if (!starTexture) {
+        return nullptr;
+    }
+    auto starNode = PolygonNode::allocWithTexture(starTexture);
+    
+    // Scale star to be 1.2x the button width
+    float starScale = (buttonSize * 1.1f) / starTexture->getWidth();
+    starNode->setScale(starScale);
+    
+    // Position star so half of it overlays the top of the button
+    // Button anchor is CENTER, so the button's top is at position.y + buttonSize/2
+    float starHeight = starTexture->getHeight() * starScale;
+    float starY = position.y + (buttonSize / 2) - (starHeight / 10);
+    
+    starNode->setAnchor(Vec2::ANCHOR_CENTER);
+    starNode->setPosition(position.x, starY);
+    starNode->setPriority(1001); // Higher priority than buttons (1000)
+    return starNode;
+}
+
 void HelloApp::buildLevelScene() {
     Size displaySize = getDisplaySize();
     
     // Add background to level scene
-    if (_levelBackground) {
+    if (_levelBackground && !_levelBackground->getParent()) {
         _levelScene->addChild(_levelBackground);
     }
     
@@ -1104,7 +1611,7 @@ void HelloApp::buildLevelScene() {
         levelTitle->setAnchor(Vec2::ANCHOR_CENTER);
         levelTitle->setPosition(displaySize.width * 0.5f, displaySize.height * 0.75f);
         levelTitle->setPriority(200);  // Set priority to be above characters
-        _levelScene->addChild(levelTitle);
+        _levelLayer->addChild(levelTitle);
         
         // Store the level title for reset feature
         _levelTitle = levelTitle;
@@ -1121,7 +1628,7 @@ void HelloApp::buildLevelScene() {
                                  bearSealScale,
                                  "bearseal",
                                  _levelBearBaseY);  // Reuse existing animation base Y
-    if (combinedCharacters) _levelScene->addChild(combinedCharacters);
+    if (combinedCharacters) _levelLayer->addChild(combinedCharacters);
     
     // Grid dimensions (7x11 is the actual grid size in the game)
     const int gridWidth = 7;
@@ -1129,11 +1636,12 @@ void HelloApp::buildLevelScene() {
     
     // Calculate button size as 1.7x the regular tile size
     float buttonSize = tileSize * 1.7f;
+    _levelButtonSize = buttonSize;
     
     // Fixed 3x4 layout for level buttons
     const int COLS = 3;
     const int ROWS = 4;
-    const int TOTAL_LEVELS = 12;  // Total number of levels to display
+    const int TOTAL_LEVELS = std::min(COLS * ROWS, LevelManager::getInstance()->getTotalLevels());
     
     // Calculate adaptive spacing
     float spacing = buttonSize * 0.3f;  // 25% of button size
@@ -1156,59 +1664,25 @@ void HelloApp::buildLevelScene() {
     int level = 1;
     for (int row = 0; row < ROWS; row++) {
         for (int col = 0; col < COLS; col++) {
-            if (level <= TOTAL_LEVELS) {  // Create all 12 buttons
+            if (level <= TOTAL_LEVELS) {
                 // Calculate position in grid
                 Vec2 position(
                     startX + col * (buttonSize + BUTTON_SPACING_X),
                     startY - row * (buttonSize + BUTTON_SPACING_Y)
                 );
                 
+                // Buttons and stars are indexed by level so single levels
+                // can be swapped later; they are activated when shown
                 auto button = createLevelButton(level, position, buttonSize);
+                _levelButtons.push_back(button);
+                _levelStars.push_back(nullptr);
                 if (button) {
-                    _levelScene->addChild(button);
-                    button->activate();
-                    _levelButtons.push_back(button);
+                    _levelLayer->addChild(button);
                     
-                    // Get level score (0-3)
-                    int score = LevelManager::getInstance()->getLevelScore(level);
-                    
-                    // Add star rating based on score (0-3)
-                    std::string starTextureName;
-                    switch (score) {
-                        case 1: starTextureName = "OneStar"; break;
-                        case 2: starTextureName = "TwoStars"; break;
-                        case 3: starTextureName = "ThreeStars"; break;
-                        default: starTextureName = "NoStar"; break;
-                    }
-                    
-                    auto starTexture = _assets->get<Texture>(starTextureName);
-                    if (starTexture) {
-                        auto starNode = PolygonNode::allocWithTexture(starTexture);
-                        
-                        // Scale star to be 1.2x the button width
-                        float starScale = (buttonSize * 1.1f) / starTexture->getWidth();
-                        starNode->setScale(starScale);
-                        
-                        // Position star so half of it overlays the top of the button
-                        // Button anchor is CENTER, so the button's top is at position.y + buttonSize/2
-                        float starHeight = starTexture->getHeight() * starScale;
-                        float starY = position.y + (buttonSize / 2) - (starHeight / 10);
-                        
-                        starNode->setAnchor(Vec2::ANCHOR_CENTER);
-                        starNode->setPosition(position.x, starY);
-                        starNode->setPriority(1001); // Higher priority than buttons (1000)
-                        
-                        _levelScene->addChild(starNode);
-                        _levelStars.push_back(starNode);
-                    }
-                    
-                    // Store first 4 buttons in member variables for backward compatibility
-                    switch(level) {
-                        case 1: _level1Button = button; break;
-                        case 2: _level2Button = button; break;
-                        case 3: _level3Button = button; break;
-                        case 4: _level4Button = button; break;
-                        default: break;
+                    auto starNode = createLevelStar(level, position, buttonSize);
+                    if (starNode) {
+                        _levelLayer->addChild(starNode);
+                        _levelStars.back() = starNode;
                     }
                 }
                 level++;
@@ -1227,46 +1701,11 @@ void HelloApp::transitionToLevelSelector() {
         _transitionTime = 0;
         
         // Set initial UI opacity
-        if (_inMenuScene && _menuScene) {
-            for (auto& child : _menuScene->getChildren()) {
-                if (child != _menuBackground) {
-                    child->setColor(Color4::WHITE);
-                }
-            }
-        } else if (_inLevelScene && _levelScene) {
-            for (auto& child : _levelScene->getChildren()) {
-                if (child != _levelBackground) {
-                    child->setColor(Color4::WHITE);
-                }
-            }
-        } else if (_PolarPairsController && _PolarPairsController->getScene()) {
-            auto gameScene = _PolarPairsController->getScene();
-            for (auto& child : gameScene->getChildren()) {
-                if (child != _gameBackground) {
-                    child->setColor(Color4::WHITE);
-                }
-            }
-        } else if (_inFinishScene && _finishScene) {
-            for (auto& child : _finishScene->getChildren()) {
-                if (child != _finishBackground) {
-                    child->setColor(Color4::WHITE);
-                }
-            }
-        }
+        setFadeAlpha(255);
         
-        // If we're transitioning from game or finish scene to level selector, reinitialize the level scene
-        if (_PolarPairsController || _inFinishScene) {
-            // Clean up the old level scene
-            _levelScene = nullptr;
-            _levelButtons.clear();
-            
-            // Create a new level scene
-            _levelScene = Scene2::allocWithHint(getDisplaySize());
-            _levelScene->setSpriteBatch(_batch);
-            
-            // Rebuild the level scene
-            buildLevelScene();
-        }
+        // The level selector is shown when the fade-out finishes, once its
+        // assets are back in
+        requestGroups(LEVEL_GROUPS);
     }
 }
 
@@ -1280,15 +1719,10 @@ void HelloApp::transitionToGame(int level) {
         _isFadingOut = true;
         _transitionTime = 0;
         _selectedLevel = level;
+        requestGroups(GAME_GROUPS);
         
         // Set initial UI opacity
-        if (_levelScene) {
-            for (auto& child : _levelScene->getChildren()) {
-                if (child != _levelBackground) {
-                    child->setColor(Color4::WHITE);
-                }
-            }
-        }
+        setFadeAlpha(255);
     }
 }
 
@@ -1306,7 +1740,7 @@ void HelloApp::buildFinishScene() {
     
     // Initialize "Level Finished" text
     if (!_levelFinishedText) {
-        auto textTexture = _assets->get<Texture>("LevelFinished");
+        auto textTexture = TextureAtlas::get(_assets, "LevelFinished");
         if (textTexture) {
             _levelFinishedText = PolygonNode::allocWithTexture(textTexture);
             
@@ -1323,14 +1757,14 @@ void HelloApp::buildFinishScene() {
             _levelFinishedOrigPos = _levelFinishedText->getPosition();
             
             if (!_levelFinishedText->getParent()) {
-                _finishScene->addChild(_levelFinishedText);
+                _finishLayer->addChild(_levelFinishedText);
             }
         }
     }
     
     // Initialize star rating node with NoStar texture
     if (!_finishStarRating) {
-        auto starTexture = _assets->get<Texture>("NoStar");
+        auto starTexture = TextureAtlas::get(_assets, "NoStar");
         if (starTexture) {
             _finishStarRating = PolygonNode::allocWithTexture(starTexture);
             
@@ -1347,14 +1781,14 @@ void HelloApp::buildFinishScene() {
             _starRatingOrigPos = _finishStarRating->getPosition();
             
             if (!_finishStarRating->getParent()) {
-                _finishScene->addChild(_finishStarRating);
+                _finishLayer->addChild(_finishStarRating);
             }
         }
     }
     
     // Initialize "Highest" text
     if (!_highestText) {
-        auto highestTexture = _assets->get<Texture>("Highest");
+        auto highestTexture = TextureAtlas::get(_assets, "Highest");
         if (highestTexture) {
             _highestText = PolygonNode::allocWithTexture(highestTexture);
             
@@ -1371,15 +1805,15 @@ void HelloApp::buildFinishScene() {
             _highestTextOrigPos = _highestText->getPosition();
             
             if (!_highestText->getParent()) {
-                _finishScene->addChild(_highestText);
+                _finishLayer->addChild(_highestText);
             }
         }
     }
     
     // Create exit button in the bottom left corner (same position as restart in game)
     if (!_finishExitButton) {
-        std::shared_ptr<Texture> exitUp = _assets->get<Texture>("Exit_Up");
-        std::shared_ptr<Texture> exitDown = _assets->get<Texture>("Exit_Down");
+        std::shared_ptr<Texture> exitUp = TextureAtlas::get(_assets, "Exit_Up");
+        std::shared_ptr<Texture> exitDown = TextureAtlas::get(_assets, "Exit_Down");
         
         if (exitUp && exitDown) {
             _finishExitButton = Button::alloc(
@@ -1399,7 +1833,7 @@ void HelloApp::buildFinishScene() {
             _finishExitButton->setName("finishExit");
             _finishExitButton->addListener([=](const std::string& name, bool down) {
                 if (down) {  // On press
-                    playButtonSound(_assets);
+                    _sounds.play(SoundEvents::Event::BUTTON);
                 } else {  // On release
                     _finishExitButton->deactivate();
                     _goToNextLevel = false;  // Make sure we're not going to next level
@@ -1408,15 +1842,15 @@ void HelloApp::buildFinishScene() {
             });
             
             if (!_finishExitButton->getParent()) {
-                _finishScene->addChild(_finishExitButton);
+                _finishLayer->addChild(_finishExitButton);
             }
         }
     }
     
     // Create restart button (to replay the current level)
     if (!_finishRestartButton) {
-        std::shared_ptr<Texture> restartUp = _assets->get<Texture>("Restart");
-        std::shared_ptr<Texture> restartDown = _assets->get<Texture>("Restart_Pressed");
+        std::shared_ptr<Texture> restartUp = TextureAtlas::get(_assets, "Restart");
+        std::shared_ptr<Texture> restartDown = TextureAtlas::get(_assets, "Restart_Pressed");
         
         if (restartUp && restartDown) {
             _finishRestartButton = Button::alloc(
@@ -1437,7 +1871,7 @@ void HelloApp::buildFinishScene() {
             _finishRestartButton->setName("finishRestart");
             _finishRestartButton->addListener([=](const std::string& name, bool down) {
                 if (down) {  // On press
-                    playButtonSound(_assets);
+                    _sounds.play(SoundEvents::Event::BUTTON);
                 } else {  // On release
                     _finishRestartButton->deactivate();
                     // Set flag to restart the level directly (use the same path as "next" button)
@@ -1448,15 +1882,15 @@ void HelloApp::buildFinishScene() {
             });
             
             if (!_finishRestartButton->getParent()) {
-                _finishScene->addChild(_finishRestartButton);
+                _finishLayer->addChild(_finishRestartButton);
             }
         }
     }
     
     // Create next level button (only for levels 1-11)
     if (!_finishNextButton) {
-        std::shared_ptr<Texture> nextUp = _assets->get<Texture>("Next_Up");
-        std::shared_ptr<Texture> nextDown = _assets->get<Texture>("Next_Down");
+        std::shared_ptr<Texture> nextUp = TextureAtlas::get(_assets, "Next_Up");
+        std::shared_ptr<Texture> nextDown = TextureAtlas::get(_assets, "Next_Down");
         
         if (nextUp && nextDown) {
             _finishNextButton = Button::alloc(
@@ -1477,7 +1911,7 @@ void HelloApp::buildFinishScene() {
             _finishNextButton->setName("finishNext");
             _finishNextButton->addListener([=](const std::string& name, bool down) {
                 if (down) {  // On press
-                    playButtonSound(_assets);
+                    _sounds.play(SoundEvents::Event::BUTTON);
                 } else {  // On release
                     _finishNextButton->deactivate();
                     
@@ -1497,15 +1931,15 @@ void HelloApp::buildFinishScene() {
             });
             
             if (!_finishNextButton->getParent()) {
-                _finishScene->addChild(_finishNextButton);
+                _finishLayer->addChild(_finishNextButton);
             }
         }
     }
     
     // Set visibility of next button based on level
     if (_finishNextButton) {
-        if (_selectedLevel >= 12) {
-            // Hide for level 12 (final level)
+        if (_selectedLevel >= LevelManager::getInstance()->getTotalLevels()) {
+            // Hide for the final level
             _finishNextButton->setVisible(false);
             _finishNextButton->deactivate();
         } else {
@@ -1534,7 +1968,7 @@ void HelloApp::updateFinishSceneStars() {
     }
     
     // Update star texture if it exists
-    auto starTexture = _assets->get<Texture>(starTextureName);
+    auto starTexture = TextureAtlas::get(_assets, starTextureName);
     if (starTexture) {
         _finishStarRating->setTexture(starTexture);
     }
@@ -1548,6 +1982,10 @@ void HelloApp::transitionToFinishScene() {
     _isTransitioning = true;
     _isFadingOut = true;
     _transitionTime = 0;
+    requestGroups(FINISH_GROUPS);
+    
+    // The finish groups are the gameplay groups, so the scene can be built now
+    buildFinishScene();
     
     // Update the star rating with the current level score
     updateFinishSceneStars();
@@ -1568,7 +2006,7 @@ void HelloApp::transitionToFinishScene() {
     
     // Next button - only for non-final levels
     if (_finishNextButton) {
-        if (_selectedLevel < 12) {
+        if (_selectedLevel < LevelManager::getInstance()->getTotalLevels()) {
             _finishNextButton->setVisible(true);
             _finishNextButton->setPosition(_nextButtonOrigPos.x, offscreenY);
             _finishNextButton->activate();
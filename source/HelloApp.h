@@ -1,13 +1,29 @@
 // HelloApp.h
 #pragma once
 #include <cugl/cugl.h>
+#include <chrono>
+#include <ctime>
 #include "PolarPairsController.h"
+#include "FrameGovernor.h"
+#include "InputLatency.h"
+#include "AssetResidency.h"
+#include "TextureVariants.h"
+#include "SoundEvents.h"
+#include "LockstepTransport.h"
+#include "LevelWatcher.h"
 
 /**
  * Main application class for the PolarPairs game
  */
 class HelloApp : public cugl::Application {
 private:
+    /** Asset loading stages, run in order after the boot set */
+    enum class LoadStage {
+        MENU,        // Sea background, title art and music - everything the menu needs
+        BACKGROUND,  // Level select, gameplay and finish assets, streamed while the menu runs
+        DONE
+    };
+    
     /** The asset manager for this game */
     std::shared_ptr<cugl::AssetManager> _assets;
     
@@ -20,6 +36,11 @@ private:
     /** The level selector scene */
     std::shared_ptr<cugl::scene2::Scene2> _levelScene;
     
+    /** Parents of each scene's nodes above its background, faded as one group */
+    std::shared_ptr<cugl::scene2::SceneNode> _menuLayer;
+    std::shared_ptr<cugl::scene2::SceneNode> _levelLayer;
+    std::shared_ptr<cugl::scene2::SceneNode> _finishLayer;
+    
     /** The finish scene */
     std::shared_ptr<cugl::scene2::Scene2> _finishScene;
     
@@ -29,26 +50,20 @@ private:
     /** The start button */
     std::shared_ptr<cugl::scene2::PolygonNode> _startButton;
     
-    /** The level 1 button */
-    std::shared_ptr<cugl::scene2::Button> _level1Button;
-    
-    /** The level 2 button */
-    std::shared_ptr<cugl::scene2::Button> _level2Button;
-    
-    /** The level 3 button */
-    std::shared_ptr<cugl::scene2::Button> _level3Button;
-    
-    /** The level 4 button */
-    std::shared_ptr<cugl::scene2::Button> _level4Button;
-    
     /** Vector to store all level buttons */
     std::vector<std::shared_ptr<cugl::scene2::Button>> _levelButtons;
     
     /** Vector to store star rating images for each level */
     std::vector<std::shared_ptr<cugl::scene2::PolygonNode>> _levelStars;
     
-    /** The level 1 button down state texture */
-    std::shared_ptr<cugl::graphics::Texture> _level1DownTexture;
+    /** Levels whose score or lock changed since the level selector was last shown */
+    std::vector<int> _changedLevels;
+    
+    /** Key of the LevelManager change listener */
+    Uint32 _levelListener;
+    
+    /** Size of the level buttons, kept for rebuilding single buttons */
+    float _levelButtonSize;
     
     /** The seal image */
     std::shared_ptr<cugl::scene2::PolygonNode> _sealImage;
@@ -95,8 +110,8 @@ private:
     /** The selected level for game transition */
     int _selectedLevel;
     
-    /** The game controller */
-    std::shared_ptr<PolarPairsController> _PolarPairsController;
+    /** The game controller, scene and HUD, reused between levels until its assets are evicted */
+    std::shared_ptr<PolarPairsController> _gameController;
     
     /** Whether we are in the menu scene */
     bool _inMenuScene;
@@ -107,6 +122,9 @@ private:
     /** Whether we are in the finish scene */
     bool _inFinishScene;
     
+    /** Whether the game scene (_gameController) is showing */
+    bool _inGameScene;
+    
     /** Whether we are transitioning between scenes */
     bool _isTransitioning;
     
@@ -176,6 +194,169 @@ private:
     /** Starting position of level title touch */
     cugl::Vec2 _levelTitleTouchPos;
     
+    /** Ambient animation timer (floating backgrounds and characters), paused while idle */
+    float _ambientTime;
+    
+    /** Picks the tick rate from what is changing on screen */
+    FrameGovernor _governor;
+    
+    /** Times swipes from the touch event to the drawn frame */
+    InputLatency _latency;
+    
+    /** Connection to the other co-op player, nullptr for single player */
+    std::shared_ptr<LockstepTransport> _coopTransport;
+    
+    /** Lockstep frames shared with the other co-op player */
+    LockstepSession _coop;
+    
+    /**
+     * Opens a co-op connection if POLARPAIRS_COOP asks for one: "host",
+     * "join:<room>", or "udp:<port>:<host>:<port>" for two copies on one machine
+     */
+    void startCoop();
+    
+    /** Watches the level files in debug builds so edits show without a restart */
+    LevelWatcher _levelWatcher;
+    
+    /**
+     * Starts the level watcher in debug builds, on POLARPAIRS_LEVEL_DIR if set
+     * (e.g. the source assets/levels/ rather than the build's copy)
+     */
+    void startLevelWatcher();
+    
+    /** Reloads the level being played if its file was saved */
+    void updateLevelWatcher();
+    
+    /** Whether the governor has gone idle (ambient animation paused, cached frame shown) */
+    bool _isIdle;
+    
+    /** Offscreen copy of the last rendered frame, shown again while idle */
+    std::shared_ptr<cugl::graphics::RenderTarget> _frameCache;
+    
+    /** Whether _frameCache holds the current screen */
+    bool _frameCacheValid;
+    
+    /** Scene renders skipped since the app went idle */
+    int _skippedRenders;
+    
+    /** Process CPU clock and wall time when the app last went idle or left idle */
+    std::clock_t _spanCpu;
+    std::chrono::steady_clock::time_point _spanStart;
+    
+    /** Logs the share of one core the process used since the last idle change, and starts a new span */
+    void logCpuSpan(const char* what);
+    
+    /** Scene-scoped asset groups, loaded and evicted with the scenes that use them */
+    AssetResidency _residency;
+    
+    /** Menu and button sound effects */
+    SoundEvents _sounds;
+    
+    /** Downscaled texture variants chosen for this display */
+    TextureVariants _variants;
+    
+    /** Asset groups held by the scene on screen */
+    std::vector<std::string> _heldGroups;
+    
+    /** Asset groups acquired for the scene being switched to */
+    std::vector<std::string> _nextGroups;
+    
+    /** Whether the menu scene is waiting on its assets before it is rebuilt */
+    bool _menuPending;
+    
+    /** Registers the asset groups and acquires the ones every scene uses */
+    void initAssetGroups();
+    
+    /** Acquires the asset groups of the next scene, which load while the old one fades */
+    void requestGroups(const std::vector<std::string>& groups);
+    
+    /** Releases the old scene's asset groups once the next scene is on screen */
+    void commitGroups();
+    
+    /** Drops the menu nodes so their textures can be evicted */
+    void releaseMenuScene();
+    
+    /** Drops the level selector nodes so their textures can be evicted */
+    void releaseLevelScene();
+    
+    /** Drops the kept level selector or game controller once an asset group they draw from is evicted */
+    void dropEvictedScenes();
+    
+    /** Drops the finish scene nodes so their textures can be evicted */
+    void releaseFinishScene();
+    
+    /**
+     * Builds the level selector the first time it is shown; after that only
+     * rebuilds the buttons and stars of levels that changed
+     */
+    void refreshLevelScene();
+    
+    /** Activates or deactivates the level buttons as the selector is shown or left */
+    void setLevelButtonsActive(bool active);
+    
+    /** The asset stage currently loading */
+    LoadStage _loadStage;
+    
+    /** Loading screen shown until the menu stage is ready */
+    std::shared_ptr<cugl::scene2::Scene2> _loadingScene;
+    
+    /** Fill of the loading screen progress bar, scaled by progress */
+    std::shared_ptr<cugl::scene2::PolygonNode> _loadingBar;
+    
+    /** Whether the player tapped start before the background stage finished */
+    bool _startRequested;
+    
+    /** When onStartup began, for the startup timing report */
+    std::chrono::steady_clock::time_point _startupTime;
+    
+    /** Whether the first frame has been drawn */
+    bool _firstFrameDrawn;
+    
+    /** Returns milliseconds since onStartup began */
+    float millisSinceStartup() const;
+    
+    /** Builds the loading screen from the boot assets */
+    void buildLoadingScene();
+    
+    /** Advances the loading stages and builds scenes as their assets arrive */
+    void updateLoading();
+    
+    /** Scene holding the frame-rate readout, drawn over every other scene */
+    std::shared_ptr<cugl::scene2::Scene2> _statsScene;
+    
+    /** The frame-rate readout text */
+    std::shared_ptr<cugl::scene2::Label> _statsLabel;
+    
+    /** The asset residency readout text, below the frame rate */
+    std::shared_ptr<cugl::scene2::Label> _assetsLabel;
+    
+    /** The swipe latency readout text, below the asset residency */
+    std::shared_ptr<cugl::scene2::Label> _latencyLabel;
+    
+    /** Whether the readout is shown (and the frame-time and latency logs written) */
+    bool _showStats;
+    
+    /** Seconds since the readout text was refreshed */
+    float _statsTime;
+    
+    /** Whether three fingers were down last frame, so the readout toggles once per tap */
+    bool _statsTouchHeld;
+    
+    /** Returns true if the player is touching, clicking or holding a key */
+    bool hasInputActivity() const;
+    
+    /** Classifies what is changing on screen this frame for the governor */
+    FrameGovernor::Activity getActivity() const;
+    
+    /** Tracks the governor's idle state and invalidates the frame cache on activity */
+    void updateIdleState(FrameGovernor::Activity activity);
+    
+    /** Toggles the readout and log on F or a three-finger tap, and refreshes the text */
+    void updateStats(float timestep);
+    
+    /** Returns the scene currently on screen */
+    std::shared_ptr<cugl::scene2::Scene2> getActiveScene() const;
+    
     /** Build the menu scene */
     void buildMenuScene();
     
@@ -210,19 +391,42 @@ private:
     /** Update transition animations */
     void updateTransition(float timestep);
     
+    /** Shows the game scene at the given level, creating the controller the first time */
+    bool startGame(int level);
+    
+    /** Leaves the game scene, keeping the controller for the next level */
+    void stopGame();
+    
+    /** Adds a full-scene layer for the nodes above the background */
+    std::shared_ptr<cugl::scene2::SceneNode> createFadeLayer(const std::shared_ptr<cugl::scene2::Scene2>& scene);
+    
+    /** Returns the layer faded by transitions in the current scene */
+    std::shared_ptr<cugl::scene2::SceneNode> getFadeLayer() const;
+    
+    /** Sets the opacity (0-255) of everything above the current scene's background */
+    void setFadeAlpha(int alpha);
+    
     /** Create a level button with given level number and position */
     std::shared_ptr<cugl::scene2::Button> createLevelButton(int level, const cugl::Vec2& position, float buttonSize);
     
+    /** Create the star rating shown over the level button at the given position */
+    std::shared_ptr<cugl::scene2::PolygonNode> createLevelStar(int level, const cugl::Vec2& position, float buttonSize);
+    
     /** Calculate tile size based on display height and grid dimensions */
     float calculateTileSize() const;
     
 public:
     /** Constructor */
-    HelloApp() : _inMenuScene(true), _inLevelScene(false), _inFinishScene(false), _isTransitioning(false), 
+    HelloApp() : _inMenuScene(true), _inLevelScene(false), _inFinishScene(false), _inGameScene(false), _isTransitioning(false), 
                  _isFadingOut(false), _buttonPressed(false), _animTime(0), _transitionTime(0),
                  _sealBaseY(0), _bearBaseY(0), _levelSealBaseY(0), _levelBearBaseY(0), _backgroundBaseX(0), _backgroundBaseY(0),
                  _goToNextLevel(false), _isFinishSceneAnimating(false), _finishAnimTime(0),
-                 _levelTitleTouched(false), _levelTitleTouchTime(0) {}
+                 _levelListener(0), _levelButtonSize(0),
+                 _levelTitleTouched(false), _levelTitleTouchTime(0),
+                 _ambientTime(0), _isIdle(false), _frameCacheValid(false), _skippedRenders(0), _spanCpu(0),
+                 _showStats(false), _statsTime(0), _statsTouchHeld(false),
+                 _loadStage(LoadStage::MENU), _startRequested(false), _firstFrameDrawn(false),
+                 _menuPending(false) {}
     
     /** Destructor */
     ~HelloApp() { dispose(); }
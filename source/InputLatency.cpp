@@ -0,0 +1,173 @@
+//
+//  InputLatency.cpp
+//  PolarPairs
+//
+
+#include "InputLatency.h"
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+InputLatency::InputLatency() :
+    _hasTouch(false), _historyNext(0), _historyCount(0), _total(0),
+    _touchKey(0), _logging(false) {
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        std::fill(_history[stage], _history[stage] + HISTORY_SIZE, 0.0f);
+    }
+}
+
+void InputLatency::start() {
+    auto touch = cugl::Input::get<cugl::Touchscreen>();
+    if (!touch || _touchKey) {
+        return;
+    }
+
+    // Listeners run as the events are pumped, before the frame's update
+    _touchKey = touch->acquireKey();
+    touch->addBeginListener(_touchKey, [this](const cugl::TouchEvent& event, bool focus) {
+        markTouch();
+    });
+    touch->addMotionListener(_touchKey, [this](const cugl::TouchEvent& event, const cugl::Vec2& previous, bool focus) {
+        markTouch();
+    });
+    touch->addEndListener(_touchKey, [this](const cugl::TouchEvent& event, bool focus) {
+        markTouch();
+    });
+}
+
+void InputLatency::stop() {
+    if (_touchKey) {
+        if (auto touch = cugl::Input::get<cugl::Touchscreen>()) {
+            touch->removeBeginListener(_touchKey);
+            touch->removeMotionListener(_touchKey);
+            touch->removeEndListener(_touchKey);
+        }
+        _touchKey = 0;
+    }
+    setLogging(false);
+}
+
+void InputLatency::markTouch() {
+    _lastTouch = Clock::now();
+    _hasTouch = true;
+}
+
+void InputLatency::markRecognized() {
+    Clock::time_point now = Clock::now();
+    Sample sample;
+    sample.touch = _hasTouch ? _lastTouch : now;
+    std::fill(sample.ms, sample.ms + STAGE_COUNT, 0.0f);
+    sample.ms[(int)Stage::RECOGNIZED] = std::chrono::duration<float, std::milli>(now - sample.touch).count();
+    sample.reached = 1;
+
+    _inFlight.push_back(sample);
+    if ((int)_inFlight.size() > MAX_IN_FLIGHT) {
+        _inFlight.pop_front();
+    }
+}
+
+void InputLatency::mark(Stage stage) {
+    // Moves run one at a time in swipe order, so the oldest match is the one
+    for (auto& sample : _inFlight) {
+        if (sample.reached == (int)stage) {
+            sample.ms[(int)stage] = std::chrono::duration<float, std::milli>(Clock::now() - sample.touch).count();
+            sample.reached++;
+            return;
+        }
+    }
+}
+
+void InputLatency::markPresented() {
+    for (auto it = _inFlight.begin(); it != _inFlight.end(); ) {
+        if (it->reached != (int)Stage::PRESENTED) {
+            ++it;
+            continue;
+        }
+
+        it->ms[(int)Stage::PRESENTED] = std::chrono::duration<float, std::milli>(Clock::now() - it->touch).count();
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            _history[stage][_historyNext] = it->ms[stage];
+        }
+        _historyNext = (_historyNext + 1) % HISTORY_SIZE;
+        _historyCount = std::min(_historyCount + 1, HISTORY_SIZE);
+        _total++;
+
+        if (_logging) {
+            char line[96];
+            snprintf(line, sizeof(line), "%d,%.2f,%.2f,%.2f,%.2f\n", _total,
+                     it->ms[0], it->ms[1], it->ms[2], it->ms[3]);
+            _logBuffer += line;
+            if (_logBuffer.size() > 4096) {
+                flushLog();
+            }
+        }
+        it = _inFlight.erase(it);
+    }
+}
+
+void InputLatency::cancelPending() {
+    for (auto it = _inFlight.begin(); it != _inFlight.end(); ) {
+        if (it->reached == 1) {
+            it = _inFlight.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+float InputLatency::getPercentile(Stage stage, float p) const {
+    if (_historyCount == 0) {
+        return 0;
+    }
+    std::vector<float> sorted(_history[(int)stage], _history[(int)stage] + _historyCount);
+    size_t index = std::min(sorted.size() - 1, (size_t)(p * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+std::string InputLatency::getReadout() const {
+    if (_historyCount == 0) {
+        return "Swipe latency: no swipes yet";
+    }
+    char text[160];
+    snprintf(text, sizeof(text), "Swipe p50/p90 ms  recognize %.0f/%.0f  start %.0f/%.0f  move %.0f/%.0f  draw %.0f/%.0f  (%d)%s",
+             getPercentile(Stage::RECOGNIZED, 0.5f), getPercentile(Stage::RECOGNIZED, 0.9f),
+             getPercentile(Stage::ACCEPTED, 0.5f), getPercentile(Stage::ACCEPTED, 0.9f),
+             getPercentile(Stage::MOVED, 0.5f), getPercentile(Stage::MOVED, 0.9f),
+             getPercentile(Stage::PRESENTED, 0.5f), getPercentile(Stage::PRESENTED, 0.9f),
+             _total, _logging ? "  [log]" : "");
+    return text;
+}
+
+void InputLatency::setLogging(bool logging) {
+    if (logging == _logging) {
+        return;
+    }
+    if (logging) {
+        _logPath = cugl::Application::get()->getSaveDirectory() + "inputlatency.csv";
+        std::ofstream file(_logPath);
+        if (!file.is_open()) {
+            CULog("Could not open input latency log at: %s", _logPath.c_str());
+            return;
+        }
+        file << "swipe,recognized_ms,accepted_ms,moved_ms,presented_ms\n";
+        CULog("Writing input latency log to: %s", _logPath.c_str());
+    } else {
+        flushLog();
+        if (_historyCount > 0) {
+            CULog("%s", getReadout().c_str());
+        }
+    }
+    _logging = logging;
+}
+
+void InputLatency::flushLog() {
+    if (_logBuffer.empty()) {
+        return;
+    }
+    std::ofstream file(_logPath, std::ios::app);
+    if (file.is_open()) {
+        file << _logBuffer;
+    }
+    _logBuffer.clear();
+}
@@ -0,0 +1,124 @@
+//
+//  InputLatency.h
+//  PolarPairs
+//
+
+#ifndef __INPUT_LATENCY_H__
+#define __INPUT_LATENCY_H__
+
+#include <cugl/cugl.h>
+#include <chrono>
+#include <deque>
+#include <string>
+
+/**
+ * Measures the time from a touch to the frame that shows the move it caused.
+ *
+ * The touchscreen listeners stamp every raw touch event. A swipe then
+ * passes four marks along the input path, and each is recorded as the
+ * milliseconds since the touch event that completed the swipe:
+ *
+ *   RECOGNIZED  the controller turned the touch into a direction
+ *   ACCEPTED    the direction became a move (it may wait in the queue)
+ *   MOVED       the first frame that updated the character nodes
+ *   PRESENTED   that frame finished drawing and was handed to the display
+ *
+ * PRESENTED is taken when draw() returns, so it leaves out the compositor
+ * and display scan-out, which the app cannot see.
+ *
+ * Percentiles over the recent swipes go to the on-screen readout, and every
+ * swipe is written to inputlatency.csv in the save directory while logging.
+ */
+class InputLatency {
+public:
+    /** The marks after the touch event, in the order a swipe passes them */
+    enum class Stage {
+        RECOGNIZED = 0,
+        ACCEPTED,
+        MOVED,
+        PRESENTED
+    };
+    static constexpr int STAGE_COUNT = 4;
+
+    /** Swipes kept for the percentiles */
+    static constexpr int HISTORY_SIZE = 128;
+
+    /** Swipes waiting for their later marks; older ones are dropped */
+    static constexpr int MAX_IN_FLIGHT = 8;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Sample {
+        Clock::time_point touch;
+        float ms[STAGE_COUNT];
+        /** Number of stages marked so far */
+        int reached;
+    };
+
+    /** When the last raw touch event arrived */
+    Clock::time_point _lastTouch;
+    bool _hasTouch;
+
+    /** Swipes that have not been presented yet, oldest first */
+    std::deque<Sample> _inFlight;
+
+    /** Recent milliseconds per stage, as ring buffers */
+    float _history[STAGE_COUNT][HISTORY_SIZE];
+    int _historyNext;
+    int _historyCount;
+    int _total;
+
+    /** Touchscreen listener key, or 0 when not listening */
+    Uint32 _touchKey;
+
+    /** Latency log, written to the save directory while enabled */
+    bool _logging;
+    std::string _logPath;
+    std::string _logBuffer;
+
+    /** Marks the oldest swipe that has reached the stage before this one */
+    void mark(Stage stage);
+
+    /** Writes buffered log lines to the log file */
+    void flushLog();
+
+public:
+    InputLatency();
+    ~InputLatency() { stop(); }
+
+    /** Starts stamping touch events; does nothing without a touchscreen */
+    void start();
+
+    /** Stops listening and closes the log */
+    void stop();
+
+    /** Stamps a raw input event (called by the touch listeners) */
+    void markTouch();
+
+    /** Marks a swipe recognized; starts a new sample */
+    void markRecognized();
+
+    /** Marks the oldest recognized swipe as the move that started */
+    void markAccepted() { mark(Stage::ACCEPTED); }
+
+    /** Marks the accepted swipe as drawn moving this frame */
+    void markMoved() { mark(Stage::MOVED); }
+
+    /** Marks the end of draw; completes any swipe that moved this frame */
+    void markPresented();
+
+    /** Forgets swipes that were recognized but will never move */
+    void cancelPending();
+
+    /** Returns the given percentile (0-1) of a stage in milliseconds */
+    float getPercentile(Stage stage, float p) const;
+
+    /** Returns a one-line summary for the on-screen readout */
+    std::string getReadout() const;
+
+    /** Starts or stops the latency log (inputlatency.csv in the save directory) */
+    void setLogging(bool logging);
+};
+
+#endif /* __INPUT_LATENCY_H__ */
@@ -1,7 +1,7 @@
 #ifndef __LEVEL_DATA_H__
 #define __LEVEL_DATA_H__
 
-#include <cugl/cugl.h>
+#include <cugl/core/cu_core.h>
 #include <vector>
 #include <string>
 #include <sstream>
@@ -27,29 +27,50 @@ public:
     
     std::string name;
     
+    // Target moves for a star, from the two lines after the grid (0 if missing)
+    int bearTargetMoves = 0;
+    int penguinTargetMoves = 0;
+    
+    /** Where loadLevel reads level files (ending in a slash); empty for the asset directory's levels/ */
+    static std::string& levelDirectory() {
+        static std::string directory;
+        return directory;
+    }
+    
     static LevelData loadLevel(const std::shared_ptr<cugl::AssetManager>& assets, int levelNum) {
 
-        std::string assetDir = cugl::Application::get()->getAssetDirectory();
-        std::string levelPath = assetDir + "levels/level" + std::to_string(levelNum) + ".txt";
+        std::string levelDir = levelDirectory();
+        if (levelDir.empty()) {
+            levelDir = cugl::Application::get()->getAssetDirectory() + "levels/";
+        }
+        std::string levelPath = levelDir + "level" + std::to_string(levelNum) + ".txt";
         CULog("%s",levelPath.c_str());
         
-        std::ifstream file(levelPath);
-        if (file.is_open()) {
-            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-            file.close();
-            
-            LevelData data;
-            if (parseFromString(data, content)) {
-                CULog("Successfully loaded level %d", levelNum);
-                return data;
-            }
+        LevelData data;
+        if (loadFile(data, levelPath)) {
+            CULog("Successfully loaded level %d", levelNum);
+            return data;
         }
         
         CULog("Could not load level %d, creating default level", levelNum);
         return createDefaultLevel(levelNum);
     }
     
-private:
+    /**
+     * Load level data from a level file at any path, e.g. for tools
+     *
+     * @param data The LevelData to populate
+     * @param path The path of the level file
+     * @return true if the file was read and parsed, false otherwise
+     */
+    static bool loadFile(LevelData& data, const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+        
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return parseFromString(data, content);
+    }
+    
     /**
      * Parse level data from a string containing the level file content
      *
@@ -92,9 +113,16 @@ private:
             }
         }
         
+        // Lines 14 and 15 of the file hold the target bear and seal moves
+        if (rows.size() > 12) {
+            std::istringstream(rows[11]) >> data.bearTargetMoves;
+            std::istringstream(rows[12]) >> data.penguinTargetMoves;
+        }
+        
         return true;
     }
     
+private:
     /**
      * Parse a single cell from the level file
      *
@@ -2,13 +2,17 @@
 #include <fstream>
 #include <sstream>
 #include <sys/stat.h>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
 
 // Initialize static instance
 LevelManager* LevelManager::_instance = nullptr;
 
-LevelManager::LevelManager() {
+LevelManager::LevelManager() : _nextListenerKey(1) {
     // Use the application's save directory instead of assets
-    _saveFilePath = cugl::Application::get()->getSaveDirectory() + "level_progress.txt";
+    _saveFilePath = cugl::Application::get()->getSaveDirectory() + "level_progress.bin";
+    _legacyFilePath = cugl::Application::get()->getSaveDirectory() + "level_progress.txt";
     CULog("LevelManager constructor: Save file path set to: %s", _saveFilePath.c_str());
     
     // Create save directory if it doesn't exist
@@ -47,119 +51,156 @@ LevelManager* LevelManager::getInstance() {
 bool LevelManager::init(const std::shared_ptr<cugl::AssetManager>& assets) {
     CULog("LevelManager::init() called");
     
-    // Initialize with default values
-    _levels.clear();
+    // The level count comes from the manifest so new levels need no code change
+    uint32_t count = 0;
+    auto reader = cugl::JsonReader::allocWithAsset(LEVEL_MANIFEST);
+    auto manifest = reader ? reader->readJson() : nullptr;
+    if (manifest && manifest->has("sets")) {
+        auto sets = manifest->get("sets");
+        for (size_t i = 0; i < sets->size(); i++) {
+            auto set = sets->get((int)i);
+            if (set->getInt("id", 0) == MAIN_SET) {
+                count = (uint32_t)std::max(0, set->getInt("levels", 0));
+            }
+        }
+    }
+    if (count == 0) {
+        // Without a manifest, keep whatever count the save file has
+        CULog("No level count in %s", LEVEL_MANIFEST);
+    }
     
-    // First level is always unlocked
-    _levels.push_back({1, true, 0});
+    // Initialize with default values
+    _progress.clear();
+    resetLevels(std::max(count, 1u));
     
-    // Add other levels (locked by default)
-    for (int i = 2; i <= 12; i++) {  // 12 levels total
-        _levels.push_back({i, false, 0});
-    }
+    // Start the background writer for the progress file
+    _writer.start(_saveFilePath);
+    _stats.start(cugl::Application::get()->getSaveDirectory());
     
-    // Try to load saved progress
+    // Try to load saved progress, then the text file from older versions.
+    // The text file is only read when there is no binary file: once it has
+    // been migrated it is stale, and must not overwrite newer results.
     CULog("Attempting to load level data...");
-    if (!loadLevelData()) {
+    struct stat info;
+    bool saved = stat(_saveFilePath.c_str(), &info) == 0;
+    if (loadLevelData()) {
+        // The manifest may have added levels since the file was written
+        if (count > 0) {
+            _progress.resize(MAIN_SET, count);
+        }
+        _progress.setUnlocked(MAIN_SET, 1, true);
+    } else if (saved) {
+        // Keep the damaged file aside rather than losing it to the next save
+        std::string backup = _saveFilePath + ".bad";
+        std::remove(backup.c_str());
+        if (std::rename(_saveFilePath.c_str(), backup.c_str()) == 0) {
+            CULog("Moved unreadable level data to %s, starting empty", backup.c_str());
+        } else {
+            CULog("Unreadable level data at %s, starting empty", _saveFilePath.c_str());
+        }
+        saveLevelData();
+    } else if (loadLegacyLevelData()) {
+        CULog("Migrated level data from %s", _legacyFilePath.c_str());
+        saveLevelData();
+    } else {
         CULog("Failed to load level data, saving default state...");
         // If loading fails, save default state
-        if (!saveLevelData()) {
-            CULog("Failed to save default level data!");
-        }
+        saveLevelData();
     }
     
     return true;
 }
 
+void LevelManager::resetLevels(uint32_t count) {
+    // Shrinking to zero clears the bits; growing back starts locked with no stars
+    _progress.resize(MAIN_SET, 0);
+    _progress.resize(MAIN_SET, count);
+    
+    // First level is always unlocked
+    _progress.setUnlocked(MAIN_SET, 1, true);
+}
+
 bool LevelManager::loadLevelData() {
+    CULog("loadLevelData() called, trying to open: %s", _saveFilePath.c_str());
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream file(_saveFilePath, std::ios::binary);
+    if (!file.is_open()) {
+        CULog("Could not open level progress file at: %s", _saveFilePath.c_str());
+        return false;
+    }
+    
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ProgressStore loaded;
+    if (!loaded.deserialize(data)) {
+        CULog("Level progress file is corrupt or from an unknown version: %s", _saveFilePath.c_str());
+        return false;
+    }
+    
+    // Keep other sets in the file, but the main set must exist
+    if (loaded.getCount(MAIN_SET) == 0) {
+        loaded.resize(MAIN_SET, _progress.getCount(MAIN_SET));
+        loaded.setUnlocked(MAIN_SET, 1, true);
+    }
+    _progress = std::move(loaded);
+    
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    CULog("Loaded level data (%zu bytes) in %lld us", data.size(), (long long)micros);
+    return true;
+}
+
+bool LevelManager::loadLegacyLevelData() {
     try {
-        CULog("loadLevelData() called, trying to open: %s", _saveFilePath.c_str());
-        std::ifstream file(_saveFilePath);
+        std::ifstream file(_legacyFilePath);
         if (!file.is_open()) {
-            CULog("Could not open level progress file at: %s", _saveFilePath.c_str());
             return false;
         }
         
         std::string line;
         while (std::getline(file, line)) {
-            CULog("Read line: %s", line.c_str());
             std::istringstream iss(line);
             int level, score;
             bool unlocked;
             char colon;
             
+            // Each line has the format level:unlocked:score
             if (iss >> level >> colon >> unlocked >> colon >> score) {
-                if (level > 0 && level <= _levels.size()) {
-                    _levels[level - 1].isUnlocked = unlocked;
-                    _levels[level - 1].score = score;
+                if (level > 0 && level <= getTotalLevels()) {
+                    _progress.setUnlocked(MAIN_SET, level, unlocked || level == 1);
+                    _progress.setStars(MAIN_SET, level, score);
                 }
             }
         }
         
-        CULog("Successfully loaded level data");
         return true;
     } catch (const std::exception& e) {
-        CULog("Error loading level data: %s", e.what());
+        CULog("Error loading legacy level data: %s", e.what());
         return false;
     }
 }
 
 bool LevelManager::saveLevelData() {
-    try {
-        CULog("saveLevelData() called");
-        // Log the full path we're trying to write to
-        CULog("Attempting to save level data to: %s", _saveFilePath.c_str());
-        
-        // Check if directory exists and is writable
-        std::string saveDir = cugl::Application::get()->getSaveDirectory();
-        CULog("Save directory path: %s", saveDir.c_str());
-        
-        struct stat info;
-        if (stat(saveDir.c_str(), &info) != 0) {
-            CULog("Save directory does not exist: %s", saveDir.c_str());
-            return false;
-        }
-       /* if (!(info.st_mode & S_IWUSR)) {
-            CULog("Save directory is not writable: %s", saveDir.c_str());
-            return false;
-        }*/
-        
-        std::ofstream file(_saveFilePath);
-        if (!file.is_open()) {
-            CULog("Could not open level progress file for writing at: %s", _saveFilePath.c_str());
-            return false;
-        }
-        
-        // Write each level in format: level:unlocked:score
-        for (const auto& level : _levels) {
-            file << level.levelNumber << ":" << level.isUnlocked << ":" << level.score << "\n";
-            CULog("Writing level data: %d:%d:%d", level.levelNumber, level.isUnlocked, level.score);
-        }
-        
-        CULog("Successfully saved level data");
-        return true;
-    } catch (const std::exception& e) {
-        CULog("Error saving level data: %s", e.what());
-        return false;
-    }
+    // Memory is already up to date; the file is written behind the game
+    // with write-temp, sync and rename, so a crash cannot leave it half written
+    _writer.write(_progress.serialize());
+    return true;
 }
 
 bool LevelManager::isLevelUnlocked(int levelNumber) {
-    if (levelNumber <= 0 || levelNumber > _levels.size()) {
+    if (levelNumber <= 0) {
         return false;
     }
-    return _levels[levelNumber - 1].isUnlocked;
+    return _progress.isUnlocked(MAIN_SET, levelNumber);
 }
 
 int LevelManager::getLevelScore(int levelNumber) {
-    if (levelNumber <= 0 || levelNumber > _levels.size()) {
+    if (levelNumber <= 0) {
         return 0;
     }
-    return _levels[levelNumber - 1].score;
+    return _progress.getStars(MAIN_SET, levelNumber);
 }
 
 void LevelManager::setLevelScore(int levelNumber, int score) {
-    if (levelNumber <= 0 || levelNumber > _levels.size()) {
+    if (levelNumber <= 0 || levelNumber > getTotalLevels()) {
         return;
     }
     
@@ -167,43 +208,72 @@ void LevelManager::setLevelScore(int levelNumber, int score) {
     score = std::max(0, std::min(3, score));
     
     // Only update the score if the new score is higher than the existing one
-    if (score > _levels[levelNumber - 1].score) {
-        CULog("Updating level %d score from %d to %d", levelNumber, _levels[levelNumber - 1].score, score);
-        _levels[levelNumber - 1].score = score;
+    int previous = _progress.getStars(MAIN_SET, levelNumber);
+    if (score > previous) {
+        CULog("Updating level %d score from %d to %d", levelNumber, previous, score);
+        _progress.setStars(MAIN_SET, levelNumber, score);
         
         // If this level has a score > 0, unlock the next level
-        if (score > 0 && levelNumber < _levels.size()) {
-            _levels[levelNumber].isUnlocked = true;
+        bool unlocked = false;
+        if (score > 0 && levelNumber < getTotalLevels() && !_progress.isUnlocked(MAIN_SET, levelNumber + 1)) {
+            _progress.setUnlocked(MAIN_SET, levelNumber + 1, true);
+            unlocked = true;
         }
         
         saveLevelData();
+        notify(levelNumber);
+        if (unlocked) {
+            notify(levelNumber + 1);
+        }
     } else {
         CULog("Ignoring new score %d for level %d as it's not higher than existing score %d", 
-              score, levelNumber, _levels[levelNumber - 1].score);
+              score, levelNumber, previous);
     }
 }
 
 void LevelManager::unlockLevel(int levelNumber) {
-    if (levelNumber > 0 && levelNumber <= _levels.size()) {
-        _levels[levelNumber - 1].isUnlocked = true;
+    if (levelNumber > 0 && levelNumber <= getTotalLevels() && !_progress.isUnlocked(MAIN_SET, levelNumber)) {
+        _progress.setUnlocked(MAIN_SET, levelNumber, true);
         saveLevelData();
+        notify(levelNumber);
     }
 }
 
 void LevelManager::resetAllProgress() {
     // Reset all level data
-    _levels.clear();
-    
-    // First level is always unlocked
-    _levels.push_back({1, true, 0});
-    
-    // Add other levels (locked by default)
-    for (int i = 2; i <= 12; i++) {  // 12 levels total
-        _levels.push_back({i, false, 0});
-    }
+    resetLevels(_progress.getCount(MAIN_SET));
     
     // Save the reset state
     saveLevelData();
+    for (int level = 1; level <= getTotalLevels(); level++) {
+        notify(level);
+    }
     
     CULog("All level progress has been reset");
+}
+
+void LevelManager::shutdown() {
+    _writer.stop();
+    _stats.stop();
+}
+
+Uint32 LevelManager::addListener(const Listener& listener) {
+    Uint32 key = _nextListenerKey++;
+    _listeners.emplace_back(key, listener);
+    return key;
+}
+
+void LevelManager::removeListener(Uint32 key) {
+    for (auto it = _listeners.begin(); it != _listeners.end(); ++it) {
+        if (it->first == key) {
+            _listeners.erase(it);
+            return;
+        }
+    }
+}
+
+void LevelManager::notify(int levelNumber) {
+    for (const auto& entry : _listeners) {
+        entry.second(levelNumber);
+    }
 } 
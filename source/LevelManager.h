@@ -3,22 +3,46 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <functional>
+#include "ProgressWriter.h"
+#include "ProgressStore.h"
+#include "StatsLog.h"
 
 class LevelManager {
+public:
+    // Called with the level number whenever its score or unlocked state changes
+    using Listener = std::function<void(int levelNumber)>;
+    
 private:
     // Singleton instance
     static LevelManager* _instance;
     
-    // Level data
-    struct LevelInfo {
-        int levelNumber;
-        bool isUnlocked;
-        int score;  // 0-3 stars
-    };
-    std::vector<LevelInfo> _levels;
+    // Level set of the levels in assets/levels
+    static constexpr uint16_t MAIN_SET = 1;
+    
+    // Level set manifest, giving the number of levels in each set
+    static constexpr const char* LEVEL_MANIFEST = "json/levels.json";
+    
+    // Level data (stars and unlocked state, packed)
+    ProgressStore _progress;
     
     // File paths
     std::string _saveFilePath;
+    // Text save file from older versions, read once and migrated
+    std::string _legacyFilePath;
+    
+    // Writes the progress file on a background thread
+    ProgressWriter _writer;
+    
+    // Attempts, times and moves per level, for tuning
+    StatsLog _stats;
+    
+    // Change listeners by key
+    std::vector<std::pair<Uint32, Listener>> _listeners;
+    Uint32 _nextListenerKey;
+    
+    // Tell the listeners that a level changed
+    void notify(int levelNumber);
     
     // Private constructor for singleton
     LevelManager();
@@ -26,7 +50,13 @@ private:
     // Load level data from file
     bool loadLevelData();
     
-    // Save level data to file
+    // Load level data from the old text save file
+    bool loadLegacyLevelData();
+    
+    // Set every level to locked with no stars, except level 1
+    void resetLevels(uint32_t count);
+    
+    // Hand the level data to the background writer
     bool saveLevelData();
     
 public:
@@ -49,8 +79,20 @@ public:
     void unlockLevel(int levelNumber);
     
     // Get total number of levels
-    int getTotalLevels() const { return _levels.size(); }
+    int getTotalLevels() const { return (int)_progress.getCount(MAIN_SET); }
     
     // Reset all level progress (only keep level 1 unlocked)
     void resetAllProgress();
+    
+    // Gameplay statistics (attempts, restarts, best times)
+    StatsLog& getStats() { return _stats; }
+    
+    // Write any pending progress and stats and stop the background writers (call on quit)
+    void shutdown();
+    
+    // Add a change listener, returning a key for removing it
+    Uint32 addListener(const Listener& listener);
+    
+    // Remove the change listener with the given key
+    void removeListener(Uint32 key);
 }; 
\ No newline at end of file
@@ -0,0 +1,86 @@
+//
+//  LevelWatcher.cpp
+//  PolarPairs
+//
+
+#include "LevelWatcher.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#define LEVEL_WATCHER_INOTIFY 1
+#endif
+
+#if defined(LEVEL_WATCHER_INOTIFY)
+
+/** Returns N for a file named levelN.txt, or 0 for anything else */
+static int levelNumber(const char* name) {
+    int level = 0;
+    char suffix[8] = { 0 };
+    if (std::sscanf(name, "level%d%7s", &level, suffix) == 2 && std::strcmp(suffix, ".txt") == 0) {
+        return level;
+    }
+    return 0;
+}
+
+bool LevelWatcher::start(const std::string& directory) {
+    stop();
+    _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_fd < 0) {
+        return false;
+    }
+    _watch = inotify_add_watch(_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (_watch < 0) {
+        stop();
+        return false;
+    }
+    _directory = directory;
+    return true;
+}
+
+void LevelWatcher::stop() {
+    if (_fd >= 0) {
+        close(_fd);
+    }
+    _fd = -1;
+    _watch = -1;
+}
+
+std::vector<int> LevelWatcher::poll() {
+    std::vector<int> levels;
+    if (_fd < 0) {
+        return levels;
+    }
+
+    // One save can raise several events; each level is reported once
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t size;
+    while ((size = read(_fd, buffer, sizeof(buffer))) > 0) {
+        for (char* pos = buffer; pos < buffer + size; ) {
+            const struct inotify_event* event = (const struct inotify_event*)pos;
+            pos += sizeof(struct inotify_event) + event->len;
+            int level = event->len ? levelNumber(event->name) : 0;
+            if (level > 0 && std::find(levels.begin(), levels.end(), level) == levels.end()) {
+                levels.push_back(level);
+            }
+        }
+    }
+    return levels;
+}
+
+#else
+
+bool LevelWatcher::start(const std::string& directory) {
+    _directory = directory;
+    return false;
+}
+
+void LevelWatcher::stop() {}
+
+std::vector<int> LevelWatcher::poll() {
+    return std::vector<int>();
+}
+
+#endif
@@ -0,0 +1,46 @@
+//
+//  LevelWatcher.h
+//  PolarPairs
+//
+
+#ifndef __LEVEL_WATCHER_H__
+#define __LEVEL_WATCHER_H__
+
+#include <string>
+#include <vector>
+
+/**
+ * Watches a levels directory for edited level files, for hot-reload.
+ *
+ * Uses inotify, so it only watches on desktop Linux; elsewhere start()
+ * returns false and poll() never reports anything. Editors that save by
+ * writing a temporary file and renaming it over the level are caught as
+ * well as ones that write in place.
+ */
+class LevelWatcher {
+private:
+    int _fd;
+    int _watch;
+    std::string _directory;
+
+public:
+    LevelWatcher() : _fd(-1), _watch(-1) {}
+    ~LevelWatcher() { stop(); }
+
+    /** Starts watching directory (ending in a slash); returns false if it cannot */
+    bool start(const std::string& directory);
+
+    /** Stops watching */
+    void stop();
+
+    /** Returns true while the directory is watched */
+    bool isWatching() const { return _fd >= 0; }
+
+    /** Returns the watched directory */
+    const std::string& getDirectory() const { return _directory; }
+
+    /** Returns the numbers of the levels saved since the last poll, without blocking */
+    std::vector<int> poll();
+};
+
+#endif /* __LEVEL_WATCHER_H__ */
@@ -0,0 +1,380 @@
+//
+//  LockstepSession.cpp
+//  PolarPairs
+//
+
+#include "LockstepSession.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+/** Packet types */
+static const uint8_t PACKET_READY = 1;
+static const uint8_t PACKET_INPUT = 2;
+
+/** READY bytes: type, level, round, nonce */
+static const size_t READY_SIZE = 1 + 2 + 1 + 4;
+
+/** Bytes before the input bits: type, level, round, ack, base frame, count */
+static const size_t INPUT_HEADER = 1 + 2 + 1 + 4 + 4 + 1;
+
+LockstepSession::LockstepSession() :
+    _transport(nullptr), _role(Role::BEAR), _state(State::IDLE), _level(0), _round(0),
+    _nonce(0), _remoteRound(0), _remoteNonce(0), _remoteRoundKnown(false), _restarted(false), _remoteRunning(false), _frame(0), _accumulator(0), _sinceSend(0), _dirty(false),
+    _localBase(0), _lastScheduled(0), _remoteAcked(0), _delayNext(0), _delayCount(0),
+    _bytesSent(0), _bytesReceived(0), _packetsSent(0), _packetsReceived(0),
+    _runSeconds(0), _stallSeconds(0) {
+    std::fill(_delays, _delays + DELAY_HISTORY, 0.0f);
+}
+
+void LockstepSession::init(LockstepTransport* transport, Role role) {
+    _transport = transport;
+    _role = role;
+    _state = State::IDLE;
+    _nonce = std::random_device()();
+    _remoteRoundKnown = false;
+}
+
+void LockstepSession::begin(int level) {
+    if (!_transport) {
+        return;
+    }
+    _state = _transport->isClosed() ? State::CLOSED : State::WAITING;
+    _level = (uint16_t)level;
+    _round++;
+    _restarted = false;
+    resetFrames();
+
+    _bytesSent = 0;
+    _bytesReceived = 0;
+    _packetsSent = 0;
+    _packetsReceived = 0;
+    _runSeconds = 0;
+    _stallSeconds = 0;
+}
+
+void LockstepSession::resetFrames() {
+    _remoteRunning = false;
+    _frame = 0;
+    _accumulator = 0;
+    _sinceSend = RESEND_SECONDS;
+    _dirty = false;
+    _local.clear();
+    _localBase = 0;
+    _lastScheduled = INPUT_DELAY - 1;
+    _remote.clear();
+    _remoteAcked = 0;
+    _steps.clear();
+    _submitted.clear();
+}
+
+bool LockstepSession::takeRestart() {
+    bool restarted = _restarted;
+    _restarted = false;
+    return restarted;
+}
+
+bool LockstepSession::isNewer(uint8_t round, uint32_t nonce) const {
+    // A new nonce is a new process, whose rounds count from 1 again
+    return !_remoteRoundKnown || nonce != _remoteNonce || (int8_t)(round - _remoteRound) > 0;
+}
+
+void LockstepSession::end() {
+    if (_state == State::WAITING || _state == State::RUNNING) {
+        _state = State::IDLE;
+    }
+    _steps.clear();
+}
+
+void LockstepSession::update(float dt) {
+    if (!_transport || _state == State::IDLE || _state == State::CLOSED) {
+        return;
+    }
+    if (_transport->isClosed()) {
+        _state = State::CLOSED;
+        return;
+    }
+    if (!_transport->isOpen()) {
+        return;
+    }
+
+    std::vector<uint8_t> packet;
+    while (_transport->receive(packet)) {
+        _bytesReceived += packet.size();
+        _packetsReceived++;
+        receive(packet);
+    }
+
+    _sinceSend += dt;
+    if (_state == State::WAITING) {
+        if (_sinceSend >= RESEND_SECONDS) {
+            sendReady();
+        }
+        return;
+    }
+
+    // Run every frame that is due and whose remote input has arrived
+    _runSeconds += dt;
+    _accumulator += dt;
+    while (_accumulator >= FRAME_SECONDS && !_remote.empty()) {
+        step();
+        _accumulator -= FRAME_SECONDS;
+    }
+    if (_accumulator >= FRAME_SECONDS) {
+        // Stalled: run the frame as soon as the input arrives, but do not
+        // race through a backlog of frames afterwards
+        _stallSeconds += dt;
+        _accumulator = FRAME_SECONDS;
+    }
+
+    if (_dirty || _sinceSend >= RESEND_SECONDS) {
+        sendInputs();
+    }
+}
+
+void LockstepSession::receive(const std::vector<uint8_t>& packet) {
+    size_t pos = 0;
+    auto get = [&](int count) {
+        uint32_t value = 0;
+        for (int i = 0; i < count; i++) {
+            value |= (uint32_t)packet[pos++] << (8 * i);
+        }
+        return value;
+    };
+
+    if (packet.size() < 4) {
+        return;
+    }
+    uint8_t type = (uint8_t)get(1);
+    uint16_t level = (uint16_t)get(2);
+    uint8_t round = (uint8_t)get(1);
+    if (level != _level) {
+        return;
+    }
+
+    if (type == PACKET_READY) {
+        if (packet.size() < READY_SIZE) {
+            return;
+        }
+        uint32_t nonce = get(4);
+        if (_state == State::WAITING) {
+            // A late READY from an earlier attempt at this level would tie
+            // the session to a round whose inputs never come
+            if (!isNewer(round, nonce)) {
+                return;
+            }
+            _remoteRound = round;
+            _remoteNonce = nonce;
+            _remoteRoundKnown = true;
+            _state = State::RUNNING;
+            _dirty = true;
+        } else if (isNewer(round, nonce)) {
+            // The other player started the level again and we missed it:
+            // start over with it, under a new round of our own so its
+            // filter takes our READY
+            _round++;
+            resetFrames();
+            _remoteRound = round;
+            _remoteNonce = nonce;
+            _restarted = true;
+            sendReady();
+            _dirty = true;
+        } else if (round == _remoteRound && !_remoteRunning) {
+            // Our READY was lost; tell the other player we are running
+            sendReady();
+        }
+        return;
+    }
+
+    if (type != PACKET_INPUT || _state != State::RUNNING || round != _remoteRound ||
+        packet.size() < INPUT_HEADER) {
+        return;
+    }
+    _remoteRunning = true;
+    uint32_t ack = get(4);
+    uint32_t base = get(4);
+    uint32_t count = get(1);
+    size_t presence = (count + 7) / 8;
+    size_t directions = (count + 3) / 4;
+    if (packet.size() != INPUT_HEADER + presence + directions) {
+        return;
+    }
+
+    if (ack > _remoteAcked) {
+        _remoteAcked = ack;
+        while (_localBase < std::min(_remoteAcked, _frame) && !_local.empty()) {
+            _local.pop_front();
+            _localBase++;
+        }
+    }
+
+    // Keep only the inputs that extend what is already known, in order
+    const uint8_t* bits = packet.data() + INPUT_HEADER;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t frame = base + i;
+        uint32_t next = _frame + (uint32_t)_remote.size();
+        if (frame < next) {
+            continue;
+        }
+        if (frame > next) {
+            break;
+        }
+        bool present = (bits[i / 8] >> (i % 8)) & 1;
+        int direction = (bits[presence + i / 4] >> (2 * (i % 4))) & 3;
+        _remote.push_back((int8_t)(present ? direction : NO_INPUT));
+        _dirty = true;
+    }
+}
+
+void LockstepSession::sendReady() {
+    std::vector<uint8_t> packet = {
+        PACKET_READY, (uint8_t)(_level & 0xff), (uint8_t)(_level >> 8), _round,
+        (uint8_t)(_nonce & 0xff), (uint8_t)((_nonce >> 8) & 0xff),
+        (uint8_t)((_nonce >> 16) & 0xff), (uint8_t)(_nonce >> 24)
+    };
+    _transport->send(packet);
+    _bytesSent += packet.size();
+    _packetsSent++;
+    _sinceSend = 0;
+}
+
+void LockstepSession::sendInputs() {
+    // Local inputs are fixed up to the last scheduled one, and every frame
+    // before INPUT_DELAY from now, since new swipes go no earlier than that
+    uint32_t through = std::max(_frame + INPUT_DELAY - 1, _lastScheduled);
+    while (_localBase + _local.size() <= through) {
+        _local.push_back(NO_INPUT);
+    }
+    uint32_t base = std::max(_remoteAcked, _localBase);
+    uint32_t count = base <= through ? std::min<uint32_t>(through - base + 1, MAX_PACKET_FRAMES) : 0;
+    size_t presence = (count + 7) / 8;
+
+    std::vector<uint8_t> packet;
+    packet.reserve(INPUT_HEADER + presence + (count + 3) / 4);
+    auto put = [&](uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            packet.push_back((uint8_t)((value >> (8 * i)) & 0xff));
+        }
+    };
+    put(PACKET_INPUT, 1);
+    put(_level, 2);
+    put(_round, 1);
+    put(_frame + (uint32_t)_remote.size(), 4);
+    put(base, 4);
+    put(count, 1);
+
+    packet.resize(INPUT_HEADER + presence + (count + 3) / 4, 0);
+    uint8_t* bits = packet.data() + INPUT_HEADER;
+    for (uint32_t i = 0; i < count; i++) {
+        int direction = _local[base + i - _localBase];
+        if (direction != NO_INPUT) {
+            bits[i / 8] |= (uint8_t)(1 << (i % 8));
+            bits[presence + i / 4] |= (uint8_t)(direction << (2 * (i % 4)));
+        }
+    }
+
+    _transport->send(packet);
+    _bytesSent += packet.size();
+    _packetsSent++;
+    _sinceSend = 0;
+    _dirty = false;
+}
+
+void LockstepSession::step() {
+    int local = NO_INPUT;
+    if (_frame >= _localBase && _frame - _localBase < _local.size()) {
+        local = _local[_frame - _localBase];
+    }
+    int remote = _remote.front();
+    _remote.pop_front();
+
+    if (local != NO_INPUT || remote != NO_INPUT) {
+        Step next;
+        next.frame = _frame;
+        next.bear = _role == Role::BEAR ? local : remote;
+        next.penguin = _role == Role::BEAR ? remote : local;
+        _steps.push_back(next);
+    }
+
+    // Input delay: from the swipe to the frame that runs it
+    while (!_submitted.empty() && _submitted.front().first <= _frame) {
+        float ms = std::chrono::duration<float, std::milli>(Clock::now() - _submitted.front().second).count();
+        _delays[_delayNext] = ms;
+        _delayNext = (_delayNext + 1) % DELAY_HISTORY;
+        _delayCount = std::min(_delayCount + 1, DELAY_HISTORY);
+        _submitted.pop_front();
+    }
+
+    _frame++;
+    _dirty = true;
+}
+
+bool LockstepSession::submit(int direction) {
+    if (_state != State::RUNNING || direction < 0 || direction > 3) {
+        return false;
+    }
+
+    // One swipe per frame, never earlier than a swipe already made
+    uint32_t frame = std::max(_frame + INPUT_DELAY, _lastScheduled + 1);
+    if (frame - _frame > MAX_PACKET_FRAMES / 2) {
+        return false;
+    }
+    while (_localBase + _local.size() <= frame) {
+        _local.push_back(NO_INPUT);
+    }
+    _local[frame - _localBase] = (int8_t)direction;
+    _lastScheduled = frame;
+    _submitted.emplace_back(frame, Clock::now());
+    _dirty = true;
+    return true;
+}
+
+bool LockstepSession::pop(Step& step) {
+    if (_steps.empty()) {
+        return false;
+    }
+    step = _steps.front();
+    _steps.pop_front();
+    return true;
+}
+
+bool LockstepSession::isStalled() const {
+    return _state == State::RUNNING && _remote.empty() && _accumulator >= FRAME_SECONDS;
+}
+
+float LockstepSession::getDelayPercentile(float p) const {
+    if (_delayCount == 0) {
+        return 0;
+    }
+    std::vector<float> sorted(_delays, _delays + _delayCount);
+    size_t index = std::min(sorted.size() - 1, (size_t)(p * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+std::string LockstepSession::getReport() const {
+    float seconds = std::max(_runSeconds, 0.001f);
+    char text[200];
+    snprintf(text, sizeof(text),
+             "Co-op level %d: %.0f B/s up, %.0f B/s down (%u/%u packets), stalled %.2f of %.1f s, frame %u, input delay p50/p90 %.0f/%.0f ms",
+             _level, _bytesSent / seconds, _bytesReceived / seconds, _packetsSent, _packetsReceived,
+             _stallSeconds, _runSeconds, _frame, getDelayPercentile(0.5f), getDelayPercentile(0.9f));
+    return text;
+}
+
+int LockstepSession::encodeDirection(int x, int y) {
+    if (y == 0 && (x == 1 || x == -1)) {
+        return x > 0 ? 0 : 1;
+    }
+    if (x == 0 && (y == 1 || y == -1)) {
+        return y > 0 ? 2 : 3;
+    }
+    return NO_INPUT;
+}
+
+void LockstepSession::decodeDirection(int code, int& x, int& y) {
+    static const int DX[4] = { 1, -1, 0, 0 };
+    static const int DY[4] = { 0, 0, 1, -1 };
+    x = (code >= 0 && code < 4) ? DX[code] : 0;
+    y = (code >= 0 && code < 4) ? DY[code] : 0;
+}
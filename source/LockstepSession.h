@@ -0,0 +1,209 @@
+//
+//  LockstepSession.h
+//  PolarPairs
+//
+
+#ifndef __LOCKSTEP_SESSION_H__
+#define __LOCKSTEP_SESSION_H__
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * Carries co-op packets between the two players.
+ *
+ * Delivery may be unreliable and unordered; the lockstep session resends
+ * whatever has not been acknowledged.
+ */
+class LockstepTransport {
+public:
+    virtual ~LockstepTransport() {}
+
+    /** Returns true once packets can flow to the other player */
+    virtual bool isOpen() = 0;
+    /** Returns true if the connection has failed or been closed */
+    virtual bool isClosed() = 0;
+    /** Sends one packet to the other player */
+    virtual void send(const std::vector<uint8_t>& data) = 0;
+    /** Takes the next received packet, returning false if there is none */
+    virtual bool receive(std::vector<uint8_t>& data) = 0;
+    /** Closes the connection */
+    virtual void close() = 0;
+};
+
+/**
+ * Two-player co-op by deterministic lockstep.
+ *
+ * Each player drives one animal: the host the bear, the other the penguin.
+ * Time is cut into frames of FRAME_SECONDS, and a swipe is scheduled
+ * INPUT_DELAY frames ahead so it normally reaches the other player before
+ * that frame is due. Only inputs cross the wire, one 2-bit direction per
+ * frame plus a presence bit; both players run the same moves on the same
+ * frames, so the boards never diverge. A frame is not run until the other
+ * player's input for it is known, and the game stalls rather than guesses.
+ *
+ * Every packet carries every input the other player has not acknowledged,
+ * so lost or reordered packets need no separate retransmission.
+ */
+class LockstepSession {
+public:
+    /** Seconds per lockstep frame */
+    static constexpr float FRAME_SECONDS = 1.0f / 30.0f;
+    /** Frames between a swipe and the frame it runs on */
+    static constexpr int INPUT_DELAY = 3;
+    /** Marks a frame where a player did not swipe */
+    static constexpr int NO_INPUT = -1;
+
+    /** Which animal the local player drives */
+    enum class Role { BEAR, PENGUIN };
+
+    /** The inputs both players made for one frame */
+    struct Step {
+        uint32_t frame;
+        /** Direction codes (see encodeDirection), or NO_INPUT */
+        int bear;
+        int penguin;
+    };
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    enum class State { IDLE, WAITING, RUNNING, CLOSED };
+
+    /** How many frames of history a packet may carry */
+    static constexpr int MAX_PACKET_FRAMES = 240;
+    /** Seconds between packets when nothing else prompts one */
+    static constexpr float RESEND_SECONDS = 0.1f;
+    /** Recent input delays kept for the percentiles */
+    static constexpr int DELAY_HISTORY = 128;
+
+    LockstepTransport* _transport;
+    Role _role;
+    State _state;
+
+    /** The level both players must be on */
+    uint16_t _level;
+    /** Counts begin() calls, so packets from an earlier round are ignored */
+    uint8_t _round;
+    /** Random per init(), sent in READY so a restarted process is told apart from a late packet */
+    uint32_t _nonce;
+    /** The other player's round and nonce, from the last READY accepted; kept across rounds */
+    uint8_t _remoteRound;
+    uint32_t _remoteNonce;
+    /** Whether a READY has been accepted on this transport yet */
+    bool _remoteRoundKnown;
+    /** Whether the other player restarted the round under us, until takeRestart() */
+    bool _restarted;
+    /** Whether inputs have arrived, proving the other player is running too */
+    bool _remoteRunning;
+
+    /** The next frame to run */
+    uint32_t _frame;
+    /** Time owed to frames not yet run */
+    float _accumulator;
+    /** Time since the last packet was sent */
+    float _sinceSend;
+    /** Whether something new needs sending before RESEND_SECONDS */
+    bool _dirty;
+
+    /** Local inputs for frames from _localBase on, most recent at the back */
+    std::deque<int8_t> _local;
+    uint32_t _localBase;
+    /** The last frame a local input was scheduled on */
+    uint32_t _lastScheduled;
+    /** Remote inputs for frames from _frame on, as far as they are known */
+    std::deque<int8_t> _remote;
+    /** The last frame of local input the other player has acknowledged, plus one */
+    uint32_t _remoteAcked;
+
+    /** Frames run, in order, waiting to be taken */
+    std::deque<Step> _steps;
+
+    /** When each pending local input was made, to measure the input delay */
+    std::deque<std::pair<uint32_t, Clock::time_point>> _submitted;
+    float _delays[DELAY_HISTORY];
+    int _delayNext;
+    int _delayCount;
+
+    /** Traffic and stall totals since begin() */
+    uint64_t _bytesSent;
+    uint64_t _bytesReceived;
+    uint32_t _packetsSent;
+    uint32_t _packetsReceived;
+    float _runSeconds;
+    float _stallSeconds;
+
+    /** Handles one packet from the other player */
+    void receive(const std::vector<uint8_t>& packet);
+    /** Returns true if a READY comes from a newer round or process than the last one accepted */
+    bool isNewer(uint8_t round, uint32_t nonce) const;
+    /** Clears the frames and inputs for a fresh round */
+    void resetFrames();
+    /** Sends a READY, or the unacknowledged inputs */
+    void sendReady();
+    void sendInputs();
+    /** Runs one frame whose inputs are both known */
+    void step();
+
+    float getDelayPercentile(float p) const;
+
+public:
+    LockstepSession();
+
+    /** Uses transport to talk to the other player, who drives the other animal */
+    void init(LockstepTransport* transport, Role role);
+
+    /** Starts a round on level, waiting for the other player to start it too */
+    void begin(int level);
+
+    /** Stops the round; the transport stays open */
+    void end();
+
+    /** Sends, receives and runs every frame that is due */
+    void update(float dt);
+
+    /**
+     * Schedules a local swipe (a direction code) for a future frame.
+     *
+     * Returns false if no round is running, or too many swipes are queued.
+     */
+    bool submit(int direction);
+
+    /** Takes the next frame run, returning false if there is none */
+    bool pop(Step& step);
+
+    /**
+     * Returns true once after the other player restarted the level while
+     * this side was running it; the round starts again from frame 0, so
+     * the caller reloads the level
+     */
+    bool takeRestart();
+
+    /** Returns true once both players are on the level */
+    bool isRunning() const { return _state == State::RUNNING; }
+
+    /** Returns true while waiting for the other player to start the level */
+    bool isWaiting() const { return _state == State::WAITING; }
+
+    /** Returns true if the connection has been lost */
+    bool isClosed() const { return _state == State::CLOSED; }
+
+    /** Returns true if the other player's input is holding the game back */
+    bool isStalled() const;
+
+    Role getRole() const { return _role; }
+
+    /** Returns bandwidth, stall and input delay figures for the log */
+    std::string getReport() const;
+
+    /** Codes a unit direction as 0-3, or NO_INPUT if it is not one */
+    static int encodeDirection(int x, int y);
+
+    /** Decodes a direction code into a unit direction */
+    static void decodeDirection(int code, int& x, int& y);
+};
+
+#endif /* __LOCKSTEP_SESSION_H__ */
@@ -0,0 +1,186 @@
+//
+//  LockstepTransport.cpp
+//  PolarPairs
+//
+
+#include "LockstepTransport.h"
+#include <cstring>
+#if !defined(__WINDOWS__)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace cugl::netcode;
+
+bool NetcodeTransport::init(const std::shared_ptr<cugl::JsonValue>& config, const std::string& room) {
+    static bool started = false;
+    if (!started) {
+        started = NetworkLayer::start(NetworkLayer::Log::WARNING);
+    }
+
+    NetcodeConfig setup(config);
+    _host = room.empty();
+    _connection = _host ? NetcodeConnection::alloc(setup) : NetcodeConnection::alloc(setup, room);
+    if (!_connection || !_connection->open()) {
+        CULog("Could not open a co-op connection");
+        _connection = nullptr;
+        return false;
+    }
+    if (_host) {
+        CULog("Co-op: hosting a new room");
+    } else {
+        CULog("Co-op: joining room %s", room.c_str());
+    }
+    return true;
+}
+
+bool NetcodeTransport::isOpen() {
+    if (!_connection) {
+        return false;
+    }
+
+    auto state = _connection->getState();
+    if (state == NetcodeConnection::State::CONNECTED && _host) {
+        // The room id is known once connected; the game starts with two players
+        if (_room != _connection->getRoom()) {
+            _room = _connection->getRoom();
+            CULog("Co-op room: %s", _room.c_str());
+        }
+        if (_connection->getNumPlayers() >= 2) {
+            _connection->startSession();
+        }
+    }
+    return state == NetcodeConnection::State::INSESSION;
+}
+
+bool NetcodeTransport::isClosed() {
+    if (!_connection) {
+        return true;
+    }
+    switch (_connection->getState()) {
+        case NetcodeConnection::State::DISCONNECTED:
+        case NetcodeConnection::State::DENIED:
+        case NetcodeConnection::State::MISMATCHED:
+        case NetcodeConnection::State::INVALID:
+        case NetcodeConnection::State::FAILED:
+        case NetcodeConnection::State::DISPOSED:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void NetcodeTransport::send(const std::vector<uint8_t>& data) {
+    if (_connection) {
+        std::vector<std::byte> bytes(data.size());
+        std::memcpy(bytes.data(), data.data(), data.size());
+        _connection->broadcast(bytes);
+    }
+}
+
+bool NetcodeTransport::receive(std::vector<uint8_t>& data) {
+    if (_inbox.empty() && _connection) {
+        _connection->receive([this](const std::string source, const std::vector<std::byte>& message) {
+            std::vector<uint8_t> packet(message.size());
+            std::memcpy(packet.data(), message.data(), message.size());
+            _inbox.push_back(std::move(packet));
+        });
+    }
+    if (_inbox.empty()) {
+        return false;
+    }
+    data.swap(_inbox.front());
+    _inbox.pop_front();
+    return true;
+}
+
+void NetcodeTransport::close() {
+    if (_connection) {
+        _connection->close();
+        _connection = nullptr;
+    }
+    _inbox.clear();
+}
+
+#if !defined(__WINDOWS__)
+
+bool UdpTransport::init(int localPort, const std::string& remoteHost, int remotePort) {
+    close();
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* found = nullptr;
+    if (getaddrinfo(remoteHost.c_str(), std::to_string(remotePort).c_str(), &hints, &found) != 0 || !found) {
+        CULog("Co-op: could not resolve %s", remoteHost.c_str());
+        return false;
+    }
+    _address.assign((const uint8_t*)found->ai_addr, (const uint8_t*)found->ai_addr + found->ai_addrlen);
+    freeaddrinfo(found);
+
+    _socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (_socket < 0) {
+        return false;
+    }
+    sockaddr_in local;
+    std::memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons((uint16_t)localPort);
+    if (bind(_socket, (const sockaddr*)&local, sizeof(local)) != 0) {
+        CULog("Co-op: could not bind UDP port %d", localPort);
+        close();
+        return false;
+    }
+    fcntl(_socket, F_SETFL, fcntl(_socket, F_GETFL, 0) | O_NONBLOCK);
+    CULog("Co-op: UDP port %d talking to %s:%d", localPort, remoteHost.c_str(), remotePort);
+    return true;
+}
+
+void UdpTransport::send(const std::vector<uint8_t>& data) {
+    if (_socket >= 0) {
+        sendto(_socket, data.data(), data.size(), 0, (const sockaddr*)_address.data(), (socklen_t)_address.size());
+    }
+}
+
+bool UdpTransport::receive(std::vector<uint8_t>& data) {
+    if (_socket < 0) {
+        return false;
+    }
+    uint8_t buffer[1500];
+    ssize_t size = recvfrom(_socket, buffer, sizeof(buffer), 0, nullptr, nullptr);
+    if (size <= 0) {
+        return false;
+    }
+    data.assign(buffer, buffer + size);
+    return true;
+}
+
+void UdpTransport::close() {
+    if (_socket >= 0) {
+        ::close(_socket);
+        _socket = -1;
+    }
+}
+
+#else
+
+bool UdpTransport::init(int localPort, const std::string& remoteHost, int remotePort) {
+    CULog("Co-op over UDP is not available on Windows; use netcode");
+    return false;
+}
+
+void UdpTransport::send(const std::vector<uint8_t>& data) {}
+
+bool UdpTransport::receive(std::vector<uint8_t>& data) {
+    return false;
+}
+
+void UdpTransport::close() {}
+
+#endif
@@ -0,0 +1,72 @@
+//
+//  LockstepTransport.h
+//  PolarPairs
+//
+
+#ifndef __LOCKSTEP_TRANSPORT_H__
+#define __LOCKSTEP_TRANSPORT_H__
+
+#include <cugl/cugl.h>
+#include <deque>
+#include "LockstepSession.h"
+
+/**
+ * Co-op over CUGL netcode (WebRTC data channels through a lobby server).
+ *
+ * The host opens a room and starts the session once the second player has
+ * joined; the room id is logged for the other player to join with.
+ */
+class NetcodeTransport : public LockstepTransport {
+private:
+    std::shared_ptr<cugl::netcode::NetcodeConnection> _connection;
+    std::deque<std::vector<uint8_t>> _inbox;
+    bool _host;
+    /** The room id last logged for the other player */
+    std::string _room;
+
+public:
+    NetcodeTransport() : _host(false) {}
+    ~NetcodeTransport() { close(); }
+
+    /**
+     * Opens a connection with the lobby settings in config.
+     *
+     * An empty room hosts a new room; otherwise the room is joined.
+     */
+    bool init(const std::shared_ptr<cugl::JsonValue>& config, const std::string& room);
+
+    bool isOpen() override;
+    bool isClosed() override;
+    void send(const std::vector<uint8_t>& data) override;
+    bool receive(std::vector<uint8_t>& data) override;
+    void close() override;
+};
+
+/**
+ * Co-op over UDP, for two processes on one machine or a LAN.
+ *
+ * There is no lobby or signalling: each side is told its own port and the
+ * other side's address, which is enough for testing lockstep on loopback.
+ * Not available on Windows.
+ */
+class UdpTransport : public LockstepTransport {
+private:
+    int _socket;
+    /** The remote sockaddr, kept as bytes so this header needs no socket headers */
+    std::vector<uint8_t> _address;
+
+public:
+    UdpTransport() : _socket(-1) {}
+    ~UdpTransport() { close(); }
+
+    /** Binds the local port and aims packets at the remote host and port */
+    bool init(int localPort, const std::string& remoteHost, int remotePort);
+
+    bool isOpen() override { return _socket >= 0; }
+    bool isClosed() override { return _socket < 0; }
+    void send(const std::vector<uint8_t>& data) override;
+    bool receive(std::vector<uint8_t>& data) override;
+    void close() override;
+};
+
+#endif /* __LOCKSTEP_TRANSPORT_H__ */
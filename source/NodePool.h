@@ -0,0 +1,111 @@
+#ifndef __NODE_POOL_H__
+#define __NODE_POOL_H__
+
+#include <cugl/cugl.h>
+#include <functional>
+#include <vector>
+
+/**
+ * A free list of scene nodes of a single type.
+ *
+ * Effects that come and go during play (break sprites, finish flags) take a
+ * node with obtain() and hand it back with release() instead of allocating a
+ * new one each time. The pool is pre-warmed at level load with the number of
+ * nodes the board can use at once, so gameplay never has to allocate.
+ *
+ * Nodes come back detached from their parent; callers reset any state
+ * (color, scale, frame) they change before adding the node to the scene.
+ */
+template <typename T>
+class NodePool {
+private:
+    /** Allocates a new node when the pool runs dry */
+    std::function<std::shared_ptr<T>()> _factory;
+
+    /** Nodes ready to be handed out */
+    std::vector<std::shared_ptr<T>> _free;
+
+    /** Total nodes this pool has allocated */
+    size_t _allocated;
+
+    /** Nodes allocated by obtain() because the pre-warm count was too low */
+    size_t _grown;
+
+public:
+    NodePool() : _allocated(0), _grown(0) {}
+
+    /** Sets the factory used to allocate nodes */
+    void init(const std::function<std::shared_ptr<T>()>& factory) {
+        _factory = factory;
+    }
+
+    /**
+     * Allocates nodes until the pool owns at least count of them.
+     *
+     * Call at level load with the most nodes the level can show at once.
+     */
+    void prewarm(size_t count) {
+        if (!_factory) {
+            return;
+        }
+        _free.reserve(count);
+        while (_allocated < count) {
+            auto node = _factory();
+            if (!node) {
+                return;
+            }
+            _allocated++;
+            _free.push_back(node);
+        }
+    }
+
+    /** Returns a free node, allocating one only if the pool is empty */
+    std::shared_ptr<T> obtain() {
+        if (_free.empty()) {
+            if (!_factory) {
+                return nullptr;
+            }
+            auto node = _factory();
+            if (node) {
+                _allocated++;
+                _grown++;
+            }
+            return node;
+        }
+        auto node = _free.back();
+        _free.pop_back();
+        return node;
+    }
+
+    /** Detaches the node from its parent and returns it to the pool */
+    void release(const std::shared_ptr<T>& node) {
+        if (!node) {
+            return;
+        }
+        if (node->getParent()) {
+            node->removeFromParent();
+        }
+        _free.push_back(node);
+    }
+
+    /** Drops the free nodes; nodes still handed out are unaffected */
+    void clear() {
+        _allocated -= _free.size();
+        _free.clear();
+    }
+
+    /** Returns the number of nodes ready to be handed out */
+    size_t available() const { return _free.size(); }
+
+    /** Returns the number of nodes this pool has allocated */
+    size_t allocated() const { return _allocated; }
+
+    /** Returns the nodes obtain() has had to allocate since the last call, and resets the count */
+    size_t takeGrowth() {
+        size_t grown = _grown;
+        _grown = 0;
+        return grown;
+    }
+};
+
+#endif /* __NODE_POOL_H__ */
@@ -6,6 +6,10 @@
 //
 
 #include "PlaygroundRenderer.h"
+#include "TextureAtlas.h"
+
+// Seconds a tile takes to shrink away or grow in when shown grids change
+static const float CELL_CHANGE_SECONDS = 0.2f;
 
 // Define the static priorities map
 const std::map<int, int> PlaygroundRenderer::CELL_PRIORITIES = {
@@ -34,83 +38,102 @@ void PlaygroundRenderer::init(const std::shared_ptr<cugl::scene2::Scene2>& scene
     
     _polarBear = nullptr;
     _penguin = nullptr;
-}
-
-void PlaygroundRenderer::clear() {
-    // First, find and remove all flag nodes directly from the scene
-    std::vector<std::shared_ptr<cugl::scene2::SceneNode>> flagsToRemove;
-    
-    // Search for all children in the scene that might be flag nodes
-    for (int i = 0; i < _scene->getChildCount(); i++) {
-        auto child = _scene->getChild(i);
-        
-        // Check if this looks like a flag (based on name, priority, or position)
-        if (child && (child->getName().find("Flag") != std::string::npos || 
-                    (child->getPriority() > 30 && child->getPriority() < 100))) {
-            
-            // This is likely a flag node, add it to removal list
-            flagsToRemove.push_back(child);
-        }
-    }
     
-    // Remove all identified flag nodes
-    for (auto& flag : flagsToRemove) {
-        _scene->removeChild(flag);
-    }
-    
-    // Remove block nodes
-    for (auto it = _blockNodes.begin(); it != _blockNodes.end(); ) {
-        if (!isUIElement(*it)) {  // Only remove non-UI elements
-            _scene->removeChild(*it);
-            it = _blockNodes.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    
-    // Remove character nodes
-    if (_polarBear && !isUIElement(_polarBear)) {
-        _scene->removeChild(_polarBear);
-        _polarBear = nullptr;
-    }
-    
-    if (_penguin && !isUIElement(_penguin)) {
-        _scene->removeChild(_penguin);
-        _penguin = nullptr;
-    }
+    // Layers draw back to front in priority order. Board nodes keep their
+    // cell priorities, which now only order them within their own layer.
+    _backgroundLayer = addLayer("background", -200);
+    _foregroundLayer = addLayer("foreground", -100);
+    _floorLayer = addLayer("floor", -100, _foregroundLayer);
+    _characterLayer = addLayer("characters", 10, _foregroundLayer);
+    _blockLayer = addLayer("blocks", 20, _foregroundLayer);
+    _effectLayer = addLayer("effects", 40, _foregroundLayer);
+    _hudLayer = addLayer("hud", 1000, _foregroundLayer);
+    
+    // Effect node factories, named once here so starting an effect allocates
+    // nothing. The break sprite uses the filmstrip from gameplay.json:
+    // 6 frames in 3 columns, so 2 rows (6/3 = 2)
+    _breakSpritePool.init([=]() -> std::shared_ptr<cugl::scene2::SpriteNode> {
+        auto texture = _assets->get<cugl::graphics::Texture>("BreakIceSS");
+        auto node = texture ? cugl::scene2::SpriteNode::allocWithSheet(texture, 2, 3, 6) : nullptr;
+        if (node) node->setName("break_anim");
+        return node;
+    });
+    _bearFlagPool.init([=]() -> std::shared_ptr<cugl::scene2::PolygonNode> {
+        auto texture = TextureAtlas::get(_assets, "BearFlag");
+        auto node = texture ? cugl::scene2::PolygonNode::allocWithTexture(texture) : nullptr;
+        if (node) node->setName("BearFlag");
+        return node;
+    });
+    _sealFlagPool.init([=]() -> std::shared_ptr<cugl::scene2::PolygonNode> {
+        auto texture = TextureAtlas::get(_assets, "SealFlag");
+        auto node = texture ? cugl::scene2::PolygonNode::allocWithTexture(texture) : nullptr;
+        if (node) node->setName("SealFlag");
+        return node;
+    });
     
-    // Clear all animations - first set opacity to 0 to make sure they're invisible
-    for (auto& anim : _breakingAnimations) {
-        if (anim.sprite) {
-            // Set opacity to 0 before removal
-            anim.sprite->setColor(cugl::Color4(255, 255, 255, 0));
-            
-            if (anim.sprite->getParent()) {
-                _scene->removeChild(anim.sprite);
+    _tweens.setListener([this](const std::shared_ptr<cugl::scene2::SceneNode>& target, int event, int slot) {
+        onTweenEvent(target, event, slot);
+    });
+}
+
+void PlaygroundRenderer::onTweenEvent(const std::shared_ptr<cugl::scene2::SceneNode>& target, int event, int slot) {
+    // Grids are only resized after finishAll, so the slot is still the tween's
+    CellSlot* cell = slot >= 0 && slot < (int)_cells.size() ? &_cells[slot] : nullptr;
+    switch (event) {
+        case BREAK_DONE:
+            if (cell && cell->effect == target) {
+                cell->effect = nullptr;
             }
-        }
-    }
-    _breakingAnimations.clear();
-    
-    // Properly clean up finish block animations
-    for (auto& anim : _finishBlockAnimations) {
-        // Remove flag if it exists
-        if (anim.flag && anim.flag->getParent()) {
-            _scene->removeChild(anim.flag);
-            anim.flag = nullptr;
-        }
-        
-        // Reset block scale if it exists
-        if (anim.block) {
-            float originalScale = 1.13f * _tileSize / std::max(anim.block->getTexture()->getWidth(), anim.block->getTexture()->getHeight());
-            anim.block->setScale(originalScale);
-        }
+            _breakSpritePool.release(std::static_pointer_cast<cugl::scene2::SpriteNode>(target));
+            break;
+        case BEAR_FLAG_DONE:
+        case SEAL_FLAG_DONE:
+            if (cell && cell->flag) {
+                (event == BEAR_FLAG_DONE ? _bearFlagPool : _sealFlagPool).release(cell->flag);
+                cell->flag = nullptr;
+            }
+            break;
+        case CELL_RETIRED:
+            if (target->getParent()) {
+                target->removeFromParent();
+            }
+            break;
     }
-    _finishBlockAnimations.clear();
+}
+
+void PlaygroundRenderer::clear() {
+    // Finish all running animations - their callbacks return pooled nodes
+    // and restore block and character scales
+    _tweens.finishAll();
+    
+    // Drop the board one layer at a time; background and HUD stay
+    _floorLayer->removeAllChildren();
+    _characterLayer->removeAllChildren();
+    _blockLayer->removeAllChildren();
+    _effectLayer->removeAllChildren();
+    
+    _cells.assign(_cells.size(), CellSlot());
+    _shown.clear();
+    _polarBear = nullptr;
+    _penguin = nullptr;
+}
+
+std::shared_ptr<cugl::scene2::SceneNode> PlaygroundRenderer::addLayer(const std::string& name, int priority,
+                                                                     const std::shared_ptr<cugl::scene2::SceneNode>& parent) {
+    auto layer = cugl::scene2::SceneNode::allocWithBounds(_scene->getSize());
+    layer->setName(name);
+    layer->setPriority(priority);
+    if (parent) {
+        parent->addChild(layer);
+    } else {
+        _scene->addChild(layer);
+    }
+    return layer;
 }
 
 void PlaygroundRenderer::drawGrid(const std::vector<std::vector<int>>& grid, float gridRatio) {
     clear();
+    loadCellTextures();
     
     // Calculate grid layout
     float sceneWidth = _scene->getSize().width;
@@ -120,6 +143,13 @@ void PlaygroundRenderer::drawGrid(const std::vector<std::vector<int>>& grid, flo
     _offsetX = (sceneWidth - grid.size() * _tileSize) / 2.0f;
     _offsetY = (sceneHeight - grid[0].size() * _tileSize) / 2.0f;
     
+    // One slot per cell, sized to this grid
+    _gridWidth = static_cast<int>(grid.size());
+    _gridHeight = static_cast<int>(grid[0].size());
+    _cells.assign(_gridWidth * _gridHeight, CellSlot());
+    _shown = grid;
+    prewarmPools(grid);
+    
     // First pass: Render regular tiles, bear blocks, and penguin blocks
     for (size_t x = 0; x < grid.size(); ++x) {
         for (int y = grid[0].size() - 1; y >= 0; --y) {
@@ -171,39 +201,112 @@ void PlaygroundRenderer::drawGrid(const std::vector<std::vector<int>>& grid, flo
     }
 }
 
-std::shared_ptr<cugl::scene2::PolygonNode> PlaygroundRenderer::addCellNode(int x, int y, int cellType) {
-    std::shared_ptr<cugl::graphics::Texture> tex = nullptr;
+std::vector<GridDiff::Change> PlaygroundRenderer::showGrid(const std::vector<std::vector<int>>& grid, bool animated) {
+    if (_shown.empty() || grid.size() != _shown.size() || grid[0].size() != _shown[0].size()) {
+        drawGrid(grid);
+        return std::vector<GridDiff::Change>();
+    }
     
-    switch (cellType) {
-        case 0: // Regular floor tile
-            tex = _assets->get<cugl::graphics::Texture>("regularblock");
-            break;
-        case 1: // Obstacle - should never be called for this
-            return nullptr;
-        case 2: // Bear-only block
-            tex = _assets->get<cugl::graphics::Texture>("bearblock");
-            break;
-        case 3: // Penguin-only block
-            tex = _assets->get<cugl::graphics::Texture>("penguinblock");
-            break;
-        case 4: // Bear finish block
-            tex = _assets->get<cugl::graphics::Texture>("bearfinish");
-            break;
-        case 5: // Penguin finish block
-            tex = _assets->get<cugl::graphics::Texture>("penguinfinish");
-            break;
-        case 6: // Breakable block
-            tex = _assets->get<cugl::graphics::Texture>("breakableblock");
-            break;
-        case 7: // Invisible block - don't render anything
-            return nullptr;
-        case 8: // Empty passable - don't render anything
-            return nullptr;
-        default:
-            return nullptr; // Unknown cell type
+    // Finish breaks, flags and bounces so no effect outlives the cells it was on
+    _tweens.finishAll();
+    
+    std::vector<GridDiff::Change> changes = GridDiff::diff(_shown, grid, animated);
+    
+    // An animated change shrinks up to two tiles and grows up to two
+    _tweens.reserve(_tweens.size() + 4 * changes.size());
+    for (const auto& change : changes) {
+        applyChange(change);
+    }
+    prewarmPools(grid);
+    return changes;
+}
+
+void PlaygroundRenderer::prewarmPools(const std::vector<std::vector<int>>& grid) {
+    // Pre-warm effect pools with as many nodes as this board can show at once
+    size_t breakables = 0, bearFinishes = 0, penguinFinishes = 0;
+    for (const auto& column : grid) {
+        for (int cellType : column) {
+            if (cellType == 6) breakables++;
+            else if (cellType == 4) bearFinishes++;
+            else if (cellType == 5) penguinFinishes++;
+        }
+    }
+    _breakSpritePool.prewarm(breakables);
+    _bearFlagPool.prewarm(bearFinishes);
+    _sealFlagPool.prewarm(penguinFinishes);
+    
+    // Room for every effect at once: a break per breakable, a bounce and a
+    // flag fade per finish, and a bounce and a nudge per character
+    _tweens.reserve(breakables + 2 * (bearFinishes + penguinFinishes) + 4);
+    
+    // Growth during play means the counts above missed an effect
+    size_t grown = _breakSpritePool.takeGrowth() + _bearFlagPool.takeGrowth() + _sealFlagPool.takeGrowth();
+    if (grown > 0) {
+        CULog("Effect pools allocated %zu nodes during the last level", grown);
+    }
+}
+
+void PlaygroundRenderer::applyChange(const GridDiff::Change& change) {
+    CellSlot* slot = getSlot(change.x, change.y);
+    if (!slot) {
+        return;
+    }
+    if (!change.animated) {
+        updateCell(change.x, change.y, change.to);
+        return;
+    }
+    
+    // Take the outgoing tiles from the slot so updateCell leaves them to shrink;
+    // a broken block (8) keeps its floor tile as it is
+    bool newFloor = change.to != 8;
+    retireNode(slot->block);
+    slot->blockType = -1;
+    if (newFloor) {
+        retireNode(slot->floor);
     }
     
-    if (tex) {
+    updateCell(change.x, change.y, change.to);
+    if (newFloor) {
+        growNode(slot->floor);
+    }
+    growNode(slot->block);
+}
+
+void PlaygroundRenderer::retireNode(std::shared_ptr<cugl::scene2::PolygonNode>& node) {
+    if (!node) {
+        return;
+    }
+    _tweens.add(node, TweenEngine::Property::SCALE, node->getScale().x, 0, CELL_CHANGE_SECONDS,
+                TweenEngine::Easing::EASE_OUT_CUBIC, CELL_RETIRED);
+    node = nullptr;
+}
+
+void PlaygroundRenderer::growNode(const std::shared_ptr<cugl::scene2::PolygonNode>& node) {
+    if (node) {
+        _tweens.add(node, TweenEngine::Property::SCALE, 0, node->getScale().x, CELL_CHANGE_SECONDS,
+                    TweenEngine::Easing::EASE_OUT_CUBIC);
+    }
+}
+
+void PlaygroundRenderer::loadCellTextures() {
+    _cellTextures[0] = TextureAtlas::get(_assets, "regularblock");   // Regular floor tile
+    _cellTextures[1] = nullptr;                                      // Obstacle - not drawn
+    _cellTextures[2] = TextureAtlas::get(_assets, "bearblock");      // Bear-only block
+    _cellTextures[3] = TextureAtlas::get(_assets, "penguinblock");   // Penguin-only block
+    _cellTextures[4] = TextureAtlas::get(_assets, "bearfinish");     // Bear finish block
+    _cellTextures[5] = TextureAtlas::get(_assets, "penguinfinish");  // Penguin finish block
+    _cellTextures[6] = TextureAtlas::get(_assets, "breakableblock"); // Breakable block
+}
+
+std::shared_ptr<cugl::scene2::PolygonNode> PlaygroundRenderer::addCellNode(int x, int y, int cellType) {
+    // Invisible (7), broken (8) and unknown cells draw nothing
+    if (cellType < 0 || cellType >= CELL_TEXTURE_TYPES) {
+        return nullptr;
+    }
+    const std::shared_ptr<cugl::graphics::Texture>& tex = _cellTextures[cellType];
+    
+    CellSlot* slot = getSlot(x, y);
+    if (tex && slot) {
         auto node = cugl::scene2::PolygonNode::allocWithTexture(tex);
         float blockScale;
         
@@ -229,47 +332,46 @@ std::shared_ptr<cugl::scene2::PolygonNode> PlaygroundRenderer::addCellNode(int x
         
         node->setPosition(posX, posY);
         
-        _scene->addChild(node);
-        _blockNodes.push_back(node);
+        (cellType == 0 ? _floorLayer : _blockLayer)->addChild(node);
+        
+        // Store the handle in the cell's layer, replacing any previous node
+        if (cellType == 0) {
+            detachNode(slot->floor);
+            slot->floor = node;
+        } else {
+            detachNode(slot->block);
+            slot->block = node;
+            slot->blockType = cellType;
+        }
         return node;
     }
     return nullptr;
 }
 
+PlaygroundRenderer::CellSlot* PlaygroundRenderer::getSlot(int x, int y) {
+    if (x < 0 || y < 0 || x >= _gridWidth || y >= _gridHeight) {
+        return nullptr;
+    }
+    return &_cells[x * _gridHeight + y];
+}
+
 void PlaygroundRenderer::updateCell(int x, int y, int cellType) {
-    // First remove all nodes at this position - regular tiles and special blocks
-    for (auto it = _blockNodes.begin(); it != _blockNodes.end(); ) {
-        // Account for the offset when calculating the grid position
-        float baseX = ((*it)->getPosition().x - _offsetX - _tileSize/2.0f) / _tileSize;
-        float baseY = ((*it)->getPosition().y - _offsetY - _tileSize/2.0f) / _tileSize;
-        
-        // Adjust y-coordinate for finish and breakable blocks which have offsets
-        float nodeY = baseY;
-        int priority = (*it)->getPriority();
-        if (priority == CELL_PRIORITIES.at(4) || priority == CELL_PRIORITIES.at(5) || priority == CELL_PRIORITIES.at(6)) {
-            // Special blocks have a vertical offset we need to account for
-            nodeY = ((*it)->getPosition().y - _offsetY - _tileSize/2.0f - 0.15f * _tileSize) / _tileSize;
-        }
-        
-        if (std::abs(baseX - x) < 0.1f && std::abs(nodeY - y) < 0.1f) {
-            // For type 8 (empty passable), keep regular tiles
-            if (cellType == 8 && (*it)->getPriority() == -100) {
-                ++it;
-            } else {
-                _scene->removeChild(*it);
-                it = _blockNodes.erase(it);
-            }
-        } else {
-            ++it;
-        }
+    CellSlot* slot = getSlot(x, y);
+    if (!slot) {
+        return;
     }
+    _shown[x][y] = cellType;
     
-    // Also check for and hide any breaking animations at this position
-    for (auto& anim : _breakingAnimations) {
-        if (anim.x == x && anim.y == y && anim.sprite) {
-            // Force hide the animation sprite
-            anim.sprite->setColor(cugl::Color4(255, 255, 255, 0));
-        }
+    // First remove the nodes at this position - for type 8 (empty passable), keep the regular tile
+    detachNode(slot->block);
+    slot->blockType = -1;
+    if (cellType != 8) {
+        detachNode(slot->floor);
+    }
+    
+    // Also hide any breaking animation at this position
+    if (slot->effect) {
+        slot->effect->setColor(cugl::Color4(255, 255, 255, 0));
     }
     
     // Skip rendering for obstacles, invisible blocks, and empty passable
@@ -306,25 +408,25 @@ void PlaygroundRenderer::updateCell(int x, int y, int cellType) {
 
 void PlaygroundRenderer::createCharacters() {
     // Create polar bear sprite
-    std::shared_ptr<cugl::graphics::Texture> bearTexture = _assets->get<cugl::graphics::Texture>("polarbear");
+    std::shared_ptr<cugl::graphics::Texture> bearTexture = TextureAtlas::get(_assets, "polarbear");
     if (bearTexture) {
         _polarBear = cugl::scene2::PolygonNode::allocWithTexture(bearTexture);
         float scale = 1.0f * _tileSize / std::max(bearTexture->getWidth(), bearTexture->getHeight());
         _polarBear->setScale(scale);
         _polarBear->setAnchor(cugl::Vec2::ANCHOR_CENTER);
         _polarBear->setPriority(10);  // Characters should be at priority 10
-        _scene->addChild(_polarBear);
+        _characterLayer->addChild(_polarBear);
     }
     
     // Create penguin sprite
-    std::shared_ptr<cugl::graphics::Texture> penguinTexture = _assets->get<cugl::graphics::Texture>("penguin");
+    std::shared_ptr<cugl::graphics::Texture> penguinTexture = TextureAtlas::get(_assets, "penguin");
     if (penguinTexture) {
         _penguin = cugl::scene2::PolygonNode::allocWithTexture(penguinTexture);
         float scale = 1.0f * _tileSize / std::max(penguinTexture->getWidth(), penguinTexture->getHeight());
         _penguin->setScale(scale);
         _penguin->setAnchor(cugl::Vec2::ANCHOR_CENTER);
         _penguin->setPriority(10);  // Characters should be at priority 10
-        _scene->addChild(_penguin);
+        _characterLayer->addChild(_penguin);
     }
 }
 
@@ -383,52 +485,25 @@ cugl::Vec2 PlaygroundRenderer::getScreenPosition(int x, int y) const {
 }
 
 void PlaygroundRenderer::startBreakAnimation(int x, int y) {
-    // Check if we already have an animation for this position
-    for (auto& anim : _breakingAnimations) {
-        if (anim.x == x && anim.y == y) {
-            return; // Already animating this block
-        }
+    CellSlot* slot = getSlot(x, y);
+    if (!slot || slot->effect) {
+        return; // Off the board or already animating this block
     }
     
-    // First, remove the static breakable block texture at this position
-    for (auto it = _blockNodes.begin(); it != _blockNodes.end(); ) {
-        // Calculate base position
-        float baseX = ((*it)->getPosition().x - _offsetX - _tileSize/2.0f) / _tileSize;
-        float baseY = ((*it)->getPosition().y - _offsetY - _tileSize/2.0f) / _tileSize;
-        
-        // For breakable blocks (priority 20), account for the vertical offset
-        float nodeY = baseY;
-        if ((*it)->getPriority() == CELL_PRIORITIES.at(6)) { // Breakable block priority
-            nodeY = ((*it)->getPosition().y - _offsetY - _tileSize/2.0f - 0.15f * _tileSize) / _tileSize;
-        }
-        
-        if (std::abs(baseX - x) < 0.1f && std::abs(nodeY - y) < 0.1f) {
-            // Don't remove the regular tile (priority -100)
-            if ((*it)->getPriority() == -100) {
-                ++it;
-            } else {
-                // Remove the static breakable block
-                _scene->removeChild(*it);
-                it = _blockNodes.erase(it);
-            }
-        } else {
-            ++it;
-        }
-    }
+    // First, remove the static breakable block texture at this position (the regular tile stays)
+    detachNode(slot->block);
+    slot->blockType = -1;
+    _shown[x][y] = 8;
     
-    // Get the texture for breaking animation
-    std::shared_ptr<cugl::graphics::Texture> texture = _assets->get<cugl::graphics::Texture>("BreakIceSS");
-    if (texture) {
-        // Create a sprite node with the filmstrip texture
-        // The filmstrip information comes from the assets.json
-        // With 6 frames and 3 columns, we need 2 rows (6/3 = 2)
-        std::shared_ptr<cugl::scene2::SpriteNode> spriteNode = 
-            cugl::scene2::SpriteNode::allocWithSheet(texture, 2, 3, 6);
-        
-        // Position the animation at the correct spot
+    // Take a breaking animation sprite from the pool
+    std::shared_ptr<cugl::scene2::SpriteNode> spriteNode = _breakSpritePool.obtain();
+    if (spriteNode) {
+        // Reset the sprite, which may have played before
         spriteNode->setFrame(0); // Start at the first frame
+        spriteNode->setColor(cugl::Color4::WHITE);
         
         // Scale the node to match the block size
+        std::shared_ptr<cugl::graphics::Texture> texture = spriteNode->getTexture();
         float scale = 1.12f * _tileSize / std::max(texture->getWidth()/3, texture->getHeight()/2);
         spriteNode->setScale(scale);
         spriteNode->setAnchor(cugl::Vec2::ANCHOR_CENTER);
@@ -438,16 +513,15 @@ void PlaygroundRenderer::startBreakAnimation(int x, int y) {
         float posY = _offsetY + y * _tileSize + _tileSize / 2.0f + (0.15f * _tileSize); // Add vertical offset
         spriteNode->setPosition(posX, posY);
         
-        // Give the sprite a unique name for easier tracking
-        std::string spriteName = "break_anim_" + std::to_string(x) + "_" + std::to_string(y);
-        spriteNode->setName(spriteName);
-        
-        spriteNode->setPriority(25); // Higher than regular blocks
+        spriteNode->setPriority(25); // Higher than regular blocks, below finish blocks
         
-        _scene->addChild(spriteNode);
+        // With the blocks, so a break next to a finish tile draws under it
+        _blockLayer->addChild(spriteNode);
         
-        // Add to active animations
-        _breakingAnimations.emplace_back(x, y, spriteNode);
+        // Step through the sheet, then return the sprite to the pool
+        slot->effect = spriteNode;
+        _tweens.add(spriteNode, TweenEngine::Property::FRAME, 0, 6, _frameTime * 6,
+                    TweenEngine::Easing::LINEAR, BREAK_DONE, x * _gridHeight + y);
     }
 }
 
@@ -455,170 +529,8 @@ void PlaygroundRenderer::update(float dt) {
     // Update animation time
     _animTime += dt;
     
-    // Update breaking animations
-    for (auto it = _breakingAnimations.begin(); it != _breakingAnimations.end(); ) {
-        it->totalTime += dt;
-        if (it->totalTime >= _frameTime * 6) {
-            // Animation is complete, make the sprite invisible instead of removing it
-            if (it->sprite) {
-                // Set opacity to 0 to make it invisible
-                it->sprite->setColor(cugl::Color4(255, 255, 255, 0));
-            }
-            
-            // Mark as complete and remove from list
-            it->complete = true;
-            it = _breakingAnimations.erase(it);
-        } else {
-            // Animation still running - update the frame
-            int frame = static_cast<int>(it->totalTime / _frameTime);
-            if (frame < 6 && it->sprite) {
-                it->sprite->setFrame(frame);
-            }
-            ++it;
-        }
-    }
-    
-    // Update blocked animations
-    for (auto it = _blockedAnimations.begin(); it != _blockedAnimations.end(); ) {
-        it->progress += dt / 0.15f;  // 0.15 second animation
-        
-        if (it->progress >= 1.0f) {
-            // Animation complete, reset characters to original positions
-            if (it->bearCharacter) {
-                it->bearCharacter->setPosition(it->bearOriginalPos);
-            }
-            if (it->penguinCharacter) {
-                it->penguinCharacter->setPosition(it->penguinOriginalPos);
-            }
-            
-            it = _blockedAnimations.erase(it);
-        } else {
-            float offset = 0.0f;
-            
-            if (it->progress < 0.5f) {
-                // Moving forward phase (0 to 0.5)
-                offset = 0.2f * it->tileSize * (it->progress / 0.5f);
-            } else {
-                // Moving back phase (0.5 to 1.0)
-                offset = 0.2f * it->tileSize * (1.0f - ((it->progress - 0.5f) / 0.5f));
-            }
-            
-            // Calculate the position offset based on direction
-            cugl::Vec2 posOffset = it->direction * offset;
-            
-            // Apply offset to character positions
-            if (it->bearCharacter) {
-                it->bearCharacter->setPosition(it->bearOriginalPos + posOffset);
-            }
-            if (it->penguinCharacter) {
-                it->penguinCharacter->setPosition(it->penguinOriginalPos + posOffset);
-            }
-            
-            ++it;
-        }
-    }
-    
-    // Update character bounce animations
-    for (auto it = _characterBounceAnimations.begin(); it != _characterBounceAnimations.end(); ) {
-        it->progress += dt / 0.15f;  // 0.15 second animation (twice as fast as original)
-        
-        if (it->progress >= 1.0f) {
-            // Animation complete, reset character to normal scale
-            if (it->character) {
-                it->character->setScale(it->originalScale);
-            }
-            
-            it = _characterBounceAnimations.erase(it);
-        } else {
-            // Calculate current animation state
-            float scale = 1.0f;
-            if (it->progress < 0.5f) {
-                // Expanding phase (0 to 0.5)
-                scale = 1.0f + 0.35f * (it->progress / 0.5f);  // 35% expansion
-            } else {
-                // Contracting phase (0.5 to 1.0)
-                scale = 1.35f - 0.35f * ((it->progress - 0.5f) / 0.5f);
-            }
-            
-            // Apply scale to character
-            if (it->character) {
-                it->character->setScale(it->originalScale * scale);
-            }
-            
-            ++it;
-        }
-    }
-    
-    // Update finish block animations
-    for (auto it = _finishBlockAnimations.begin(); it != _finishBlockAnimations.end(); ) {
-        it->progress += dt / 0.4f;  // 0.4 second animation
-        
-        if (it->progress >= 1.0f) {
-            // Animation complete, reset block to normal scale
-            if (it->block) {
-                float originalScale = 1.13f * _tileSize / std::max(it->block->getTexture()->getWidth(), it->block->getTexture()->getHeight());
-                it->block->setScale(originalScale);
-            }
-            
-            // Remove flag if it exists
-            if (it->flag && it->flag->getParent()) {
-                _scene->removeChild(it->flag);
-                it->flag = nullptr;
-            }
-            
-            it = _finishBlockAnimations.erase(it);
-        } else {
-            // Calculate current animation state
-            float scale = 1.0f;
-            if (it->progress < 0.5f) {
-                // Expanding phase (0 to 0.5)
-                scale = 1.0f + 0.3f * (it->progress / 0.5f);
-            } else {
-                // Contracting phase (0.5 to 1.0)
-                scale = 1.3f - 0.3f * ((it->progress - 0.5f) / 0.5f);
-            }
-            
-            // Apply scale to finish block
-            if (it->block) {
-                float baseScale = 1.13f * _tileSize / std::max(it->block->getTexture()->getWidth(), it->block->getTexture()->getHeight());
-                it->block->setScale(baseScale * scale);
-                
-                // Create flag immediately if it doesn't exist yet
-                if (!it->flag) {
-                    std::string flagTexture = it->isBear ? "BearFlag" : "SealFlag";
-                    auto tex = _assets->get<cugl::graphics::Texture>(flagTexture);
-                    if (tex) {
-                        it->flag = cugl::scene2::PolygonNode::allocWithTexture(tex);
-                        float flagScale = 1.5f * _tileSize / tex->getHeight(); // 1.5x tile height
-                        it->flag->setScale(flagScale);
-                        it->flag->setAnchor(cugl::Vec2::ANCHOR_CENTER);
-                        
-                        // Add vertical offset of 0.2f * _tileSize to the flag position
-                        cugl::Vec2 blockPos = it->block->getPosition();
-                        cugl::Vec2 flagPos = blockPos + cugl::Vec2(0, 0.28f * _tileSize);
-                        it->flag->setPosition(flagPos);
-                        
-                        it->flag->setPriority(it->block->getPriority() + 1);  // Higher than finish block
-                        it->flag->setColor(cugl::Color4(255, 255, 255, 0));  // Start with 0 opacity
-                        _scene->addChild(it->flag);
-                        
-                        // Name the flag for better tracking
-                        std::string flagName = (it->isBear ? "BearFlag_" : "SealFlag_") + std::to_string(it->x) + "_" + std::to_string(it->y);
-                        it->flag->setName(flagName);
-                    }
-                }
-                
-                // Fade in the flag over the first 0.3 seconds (75% of the animation)
-                if (it->flag) {
-                    float fadeProgress = std::min(1.0f, it->progress / 0.75f);
-                    int alpha = static_cast<int>(255.0f * fadeProgress);
-                    it->flag->setColor(cugl::Color4(255, 255, 255, alpha));
-                }
-            }
-            
-            ++it;
-        }
-    }
+    // Advance every running animation in one pass
+    _tweens.update(dt);
 }
 
 void PlaygroundRenderer::startCharacterBounceAnimation(bool isBear) {
@@ -630,21 +542,14 @@ void PlaygroundRenderer::startCharacterBounceAnimation(bool isBear) {
     }
     
     // Check if this character is already animating
-    bool alreadyAnimating = false;
-    for (const auto& anim : _characterBounceAnimations) {
-        if (anim.isBear == isBear) {
-            alreadyAnimating = true;
-            break;
-        }
+    if (_tweens.isActive(character, TweenEngine::Property::SCALE)) {
+        return;
     }
     
-    if (!alreadyAnimating) {
-        // Get original scale
-        float originalScale = character->getScale().x;
-        
-        // Create and add the animation
-        _characterBounceAnimations.emplace_back(isBear, character, originalScale);
-    }
+    // Expand by 35% and back over 0.15 seconds
+    float originalScale = character->getScale().x;
+    _tweens.add(character, TweenEngine::Property::SCALE, originalScale, originalScale * 1.35f, 0.15f,
+                TweenEngine::Easing::PING_PONG);
 }
 
 void PlaygroundRenderer::startBlockedAnimation(const cugl::Vec2& direction) {
@@ -654,49 +559,56 @@ void PlaygroundRenderer::startBlockedAnimation(const cugl::Vec2& direction) {
     }
     
     // Check if there's already an active blocked animation
-    if (!_blockedAnimations.empty()) {
+    TweenEngine::Property axis = direction.x != 0 ? TweenEngine::Property::POSITION_X : TweenEngine::Property::POSITION_Y;
+    if (_tweens.isActive(_polarBear, TweenEngine::Property::POSITION_X) ||
+        _tweens.isActive(_polarBear, TweenEngine::Property::POSITION_Y)) {
         return;
     }
     
-    // Create and add the animation
-    _blockedAnimations.emplace_back(direction, _tileSize, _polarBear, _penguin);
+    // Nudge both characters 0.2 tiles toward the wall and back over 0.15 seconds
+    float offset = 0.2f * _tileSize * (direction.x != 0 ? direction.x : direction.y);
+    for (const auto& character : { _polarBear, _penguin }) {
+        float start = axis == TweenEngine::Property::POSITION_X ? character->getPosition().x : character->getPosition().y;
+        _tweens.add(character, axis, start, start + offset, 0.15f, TweenEngine::Easing::PING_PONG);
+    }
 }
 
 void PlaygroundRenderer::startFinishBlockAnimation(int x, int y, bool isBear) {
-    // Find the finish block node at this position
-    for (auto& node : _blockNodes) {
-        // Calculate grid position from node position, accounting for the vertical offset
-        float nodeX = (node->getPosition().x - _offsetX - _tileSize/2.0f) / _tileSize;
-        float nodeY = (node->getPosition().y - _offsetY - _tileSize/2.0f - 0.15f * _tileSize) / _tileSize;
+    // Look up the finish block node at this position
+    CellSlot* slot = getSlot(x, y);
+    if (!slot || !slot->block || slot->blockType != (isBear ? 4 : 5)) {  // Bear finish = 4, Penguin finish = 5
+        return;
+    }
+    
+    // Check if this block is already animating
+    if (slot->flag) {
+        return;
+    }
+    
+    // Take a flag from the pool and place it over the block
+    slot->flag = (isBear ? _bearFlagPool : _sealFlagPool).obtain();
+    if (slot->flag) {
+        auto tex = slot->flag->getTexture();
+        float flagScale = 1.5f * _tileSize / tex->getHeight(); // 1.5x tile height
+        slot->flag->setScale(flagScale);
+        slot->flag->setAnchor(cugl::Vec2::ANCHOR_CENTER);
         
-        if (std::abs(nodeX - x) < 0.1f && std::abs(nodeY - y) < 0.1f) {
-            // Check if it's a finish block by looking at its priority
-            int priority = node->getPriority();
-            if (priority == CELL_PRIORITIES.at(isBear ? 4 : 5)) {  // Bear finish = 4, Penguin finish = 5
-                // Cast to PolygonNode
-                auto blockNode = std::dynamic_pointer_cast<cugl::scene2::PolygonNode>(node);
-                if (blockNode) {
-                    // Check if this block is already animating
-                    bool alreadyAnimating = false;
-                    for (const auto& anim : _finishBlockAnimations) {
-                        if (anim.x == x && anim.y == y) {
-                            alreadyAnimating = true;
-                            break;
-                        }
-                    }
-                    
-                    if (!alreadyAnimating) {
-                        _finishBlockAnimations.emplace_back(x, y, isBear, blockNode);
-                    }
-                    return;
-                }
-            }
-        }
+        // Add vertical offset of 0.28f * _tileSize to the flag position
+        cugl::Vec2 blockPos = slot->block->getPosition();
+        cugl::Vec2 flagPos = blockPos + cugl::Vec2(0, 0.28f * _tileSize);
+        slot->flag->setPosition(flagPos);
+        
+        slot->flag->setPriority(slot->block->getPriority() + 1);  // Higher than finish block
+        slot->flag->setColor(cugl::Color4(255, 255, 255, 0));  // Start with 0 opacity
+        _effectLayer->addChild(slot->flag);
+        
+        // Fade in the flag over the first 0.3 seconds (75% of the animation)
+        _tweens.add(slot->flag, TweenEngine::Property::ALPHA, 0, 255, 0.3f);
     }
+    
+    // Expand the block by 30% and back over 0.4 seconds, then take the flag down
+    auto tex = slot->block->getTexture();
+    float baseScale = 1.13f * _tileSize / std::max(tex->getWidth(), tex->getHeight());
+    _tweens.add(slot->block, TweenEngine::Property::SCALE, baseScale, baseScale * 1.3f, 0.4f,
+                TweenEngine::Easing::PING_PONG, isBear ? BEAR_FLAG_DONE : SEAL_FLAG_DONE, x * _gridHeight + y);
 }
-
-bool PlaygroundRenderer::isUIElement(const std::shared_ptr<cugl::scene2::SceneNode>& node) const {
-    // Check if the node is a UI element (like buttons)
-    // UI elements typically have high priority values (>= 1000)
-    return node && node->getPriority() >= 1000;
-} 
\ No newline at end of file
@@ -7,6 +7,9 @@
 
 #pragma once
 #include <cugl/cugl.h>
+#include "NodePool.h"
+#include "TweenEngine.h"
+#include "GridDiff.h"
 
 /**
  * Class responsible for rendering the game playground (map) and all visual elements.
@@ -19,7 +22,40 @@ private:
     
     std::shared_ptr<cugl::scene2::Scene2> _scene;
     std::shared_ptr<cugl::AssetManager> _assets;
-    std::vector<std::shared_ptr<cugl::scene2::SceneNode>> _blockNodes;
+    
+    // Layer parents, drawn in this order. Each covers the whole scene with its
+    // origin at the scene origin, so children keep scene coordinates.
+    std::shared_ptr<cugl::scene2::SceneNode> _backgroundLayer;  // Scrolling background
+    std::shared_ptr<cugl::scene2::SceneNode> _foregroundLayer;  // Parent of the layers below, faded as a group
+    std::shared_ptr<cugl::scene2::SceneNode> _floorLayer;       // Regular tiles
+    std::shared_ptr<cugl::scene2::SceneNode> _characterLayer;   // Bear and seal
+    std::shared_ptr<cugl::scene2::SceneNode> _blockLayer;       // Colored, breakable and finish blocks, and break sprites
+    std::shared_ptr<cugl::scene2::SceneNode> _effectLayer;      // Flags
+    std::shared_ptr<cugl::scene2::SceneNode> _hudLayer;         // Buttons and menus
+    
+    // Node handles for a single grid cell, one slot per layer
+    struct CellSlot {
+        std::shared_ptr<cugl::scene2::PolygonNode> floor;  // Regular tile (priority -100)
+        std::shared_ptr<cugl::scene2::PolygonNode> block;  // Block or finish tile drawn in this cell
+        int blockType;                                     // Cell type shown by block, -1 if none
+        std::shared_ptr<cugl::scene2::SpriteNode> effect;  // Running break animation, if any
+        std::shared_ptr<cugl::scene2::PolygonNode> flag;   // Flag raised by a running finish animation
+        
+        CellSlot() : blockType(-1) {}
+    };
+    
+    // Slot table indexed by x * _gridHeight + y
+    std::vector<CellSlot> _cells;
+    
+    // Tile texture for each drawn cell type (0 to 6), resolved in drawGrid
+    static const int CELL_TEXTURE_TYPES = 7;
+    std::shared_ptr<cugl::graphics::Texture> _cellTextures[CELL_TEXTURE_TYPES];
+    
+    // Cell types currently drawn, [x][y]; empty until drawGrid
+    std::vector<std::vector<int>> _shown;
+    int _gridWidth;
+    int _gridHeight;
+    
     std::shared_ptr<cugl::scene2::SceneNode> _polarBear;
     std::shared_ptr<cugl::scene2::SceneNode> _penguin;
     
@@ -31,85 +67,67 @@ private:
     float _animTime;  // Animation time counter
     float _frameTime; // Animation frame time in seconds
     
-    // Structure to track breaking block animations
-    struct BreakingBlockAnimation {
-        int x;
-        int y;
-        std::shared_ptr<cugl::scene2::SpriteNode> sprite;
-        float totalTime;
-        bool complete;
-        
-        BreakingBlockAnimation(int gridX, int gridY, std::shared_ptr<cugl::scene2::SpriteNode> fs)
-            : x(gridX), y(gridY), sprite(fs), totalTime(0), complete(false) {}
-    };
+    // All running effects (breaks, finish bounces, flags, character bounces, blocked nudges)
+    TweenEngine _tweens;
     
-    // Structure to track finish block animations
-    struct FinishBlockAnimation {
-        int x;
-        int y;
-        bool isBear;
-        float progress;  // 0 to 1
-        std::shared_ptr<cugl::scene2::PolygonNode> block;
-        std::shared_ptr<cugl::scene2::PolygonNode> flag;
-        
-        FinishBlockAnimation(int gridX, int gridY, bool bear, 
-                             std::shared_ptr<cugl::scene2::PolygonNode> b)
-            : x(gridX), y(gridY), isBear(bear), progress(0), block(b), flag(nullptr) {}
+    // What a tween does when it ends; the tween data is the slot index
+    enum TweenEvent {
+        BREAK_DONE = 1,      // Return the break sprite to its pool
+        BEAR_FLAG_DONE,      // Take down the bear flag over the slot
+        SEAL_FLAG_DONE,      // Take down the seal flag over the slot
+        CELL_RETIRED         // Remove the shrunk tile from its layer
     };
     
-    // Structure to track character bounce animations
-    struct CharacterBounceAnimation {
-        bool isBear;
-        float progress;  // 0 to 1
-        float originalScale;
-        std::shared_ptr<cugl::scene2::SceneNode> character;
-        
-        CharacterBounceAnimation(bool bear, std::shared_ptr<cugl::scene2::SceneNode> c, float scale)
-            : isBear(bear), progress(0), originalScale(scale), character(c) {}
-    };
+    // Runs the end of an effect when its tween completes
+    void onTweenEvent(const std::shared_ptr<cugl::scene2::SceneNode>& target, int event, int slot);
     
-    // Structure to track blocked movement animations
-    struct BlockedAnimation {
-        float progress;  // 0 to 1
-        cugl::Vec2 direction;  // Direction of the blocked movement
-        float tileSize;  // Tile size for distance calculation
-        std::shared_ptr<cugl::scene2::SceneNode> bearCharacter;
-        std::shared_ptr<cugl::scene2::SceneNode> penguinCharacter;
-        cugl::Vec2 bearOriginalPos;
-        cugl::Vec2 penguinOriginalPos;
-        
-        BlockedAnimation(cugl::Vec2 dir, float size,
-                         std::shared_ptr<cugl::scene2::SceneNode> bear, 
-                         std::shared_ptr<cugl::scene2::SceneNode> penguin)
-            : progress(0), direction(dir), tileSize(size),
-              bearCharacter(bear), penguinCharacter(penguin),
-              bearOriginalPos(bear ? bear->getPosition() : cugl::Vec2::ZERO),
-              penguinOriginalPos(penguin ? penguin->getPosition() : cugl::Vec2::ZERO) {}
-    };
+    // Pools for transient effect nodes, pre-warmed in drawGrid
+    NodePool<cugl::scene2::SpriteNode> _breakSpritePool;
+    NodePool<cugl::scene2::PolygonNode> _bearFlagPool;
+    NodePool<cugl::scene2::PolygonNode> _sealFlagPool;
     
-    // List of active finish block animations
-    std::vector<FinishBlockAnimation> _finishBlockAnimations;
+    // Looks up the tile textures once per grid, so cells do not search the atlases
+    void loadCellTextures();
     
-    // List of active breaking block animations
-    std::vector<BreakingBlockAnimation> _breakingAnimations;
+    // Helper method to add a node for a single cell
+    std::shared_ptr<cugl::scene2::PolygonNode> addCellNode(int x, int y, int cellType);
     
-    // List of active character bounce animations
-    std::vector<CharacterBounceAnimation> _characterBounceAnimations;
+    // Grows the effect pools to what the grid can show at once
+    void prewarmPools(const std::vector<std::vector<int>>& grid);
     
-    // List of active blocked animations
-    std::vector<BlockedAnimation> _blockedAnimations;
+    // Redraws one changed cell, easing the tiles out and in if the change is animated
+    void applyChange(const GridDiff::Change& change);
     
-    // Helper method to add a node for a single cell
-    std::shared_ptr<cugl::scene2::PolygonNode> addCellNode(int x, int y, int cellType);
+    // Shrinks a slot node away, removes it from its layer when done and clears the handle
+    void retireNode(std::shared_ptr<cugl::scene2::PolygonNode>& node);
+    
+    // Grows a newly added slot node from nothing to its scale
+    void growNode(const std::shared_ptr<cugl::scene2::PolygonNode>& node);
+    
+    // Returns the slot for a grid cell, or nullptr if out of bounds
+    CellSlot* getSlot(int x, int y);
+    
+    // Removes a slot node from its layer and clears the handle
+    template <typename T>
+    void detachNode(std::shared_ptr<T>& node) {
+        if (node) {
+            if (node->getParent()) {
+                node->removeFromParent();
+            }
+            node = nullptr;
+        }
+    }
+    
+    // Creates an empty layer covering the scene and adds it at the given priority,
+    // under parent if one is given and to the scene otherwise
+    std::shared_ptr<cugl::scene2::SceneNode> addLayer(const std::string& name, int priority,
+                                                      const std::shared_ptr<cugl::scene2::SceneNode>& parent = nullptr);
     
     // Convert grid coordinates to screen coordinates
     cugl::Vec2 gridToScreenPos(float x, float y) const;
-    
-    // Helper method to check if a node is a UI element
-    bool isUIElement(const std::shared_ptr<cugl::scene2::SceneNode>& node) const;
 
 public:
-    PlaygroundRenderer() : _tileHeightRatio(0.75f), _animTime(0.0f), _frameTime(0.12f) {}
+    PlaygroundRenderer() : _gridWidth(0), _gridHeight(0), _tileHeightRatio(0.75f), _animTime(0.0f), _frameTime(0.12f) {}
     
     /**
      * Initialize the renderer
@@ -122,6 +140,15 @@ public:
      */
     void drawGrid(const std::vector<std::vector<int>>& grid, float tileHeightRatio = 0.75f);
     
+    /**
+     * Show a grid by redrawing only the cells that differ from the one shown
+     *
+     * Running effects are finished and the characters are kept. Falls back
+     * to drawGrid if nothing is drawn yet or the grid size changed. Returns
+     * the changes applied.
+     */
+    std::vector<GridDiff::Change> showGrid(const std::vector<std::vector<int>>& grid, bool animated);
+    
     /**
      * Update a single cell in the grid
      */
@@ -165,14 +192,29 @@ public:
     void startBlockedAnimation(const cugl::Vec2& direction);
     
     /**
-     * Update finish block animations
+     * Clear all board elements (floor, blocks, characters and effects)
+     *
+     * The background and HUD layers are left alone.
      */
-    void updateFinishBlockAnimations(float progress);
+    void clear();
     
     /**
-     * Clear all visual elements
+     * Get the layer for the scene background, drawn below the board
      */
-    void clear();
+    std::shared_ptr<cugl::scene2::SceneNode> getBackgroundLayer() const { return _backgroundLayer; }
+    
+    /**
+     * Get the layer for buttons and menus, drawn above the board
+     */
+    std::shared_ptr<cugl::scene2::SceneNode> getHUDLayer() const { return _hudLayer; }
+    
+    /**
+     * Get the parent of every layer above the background
+     *
+     * Its color tints the board and HUD together, so a scene fade is one
+     * color change.
+     */
+    std::shared_ptr<cugl::scene2::SceneNode> getForegroundLayer() const { return _foregroundLayer; }
     
     /**
      * Convert grid position to screen position
@@ -199,4 +241,9 @@ public:
      * Update animation and other time-based elements
      */
     void update(float dt);
+    
+    /**
+     * Returns true while any effect or character animation is running
+     */
+    bool isAnimating() const { return _tweens.size() > 0; }
 };
@@ -8,21 +8,9 @@
 #include <thread>
 #include <sstream>
 #include "LevelManager.h"
+#include "TextureAtlas.h"
 #include <cugl/audio/CUAudioEngine.h>
 
-// Special constant for "no target"
-const cugl::Vec2 NO_TARGET(-999, -999);
-
-/**
- * Helper function to play button press sound
- */
-void playButtonPressSound(const std::shared_ptr<cugl::AssetManager>& assets) {
-    auto buttonSound = assets->get<cugl::audio::Sound>("buttonSound");
-    if (buttonSound) {
-        cugl::audio::AudioEngine::get()->play("buttonPress", buttonSound, false, 0.8f);
-    }
-}
-
 /**
  * Helper method to calculate tile size based on screen height
  */
@@ -34,21 +22,29 @@ float PolarPairsController::calculateTileSize(const cugl::Size& size) const {
 }
 
 void PolarPairsController::dispose() {
+    // Quitting the app mid-level reports the level it was on
+    if (_sounds.hasReport()) {
+        CULog("Level %d %s", _currentLevel, _sounds.getReport().c_str());
+    }
+    _sounds.dispose();
     _restartButton = nullptr;
     _pauseButton = nullptr;
     _exitButton = nullptr;
     _resumeButton = nullptr;
+    _pauseLayer = nullptr;
     _pauseOverlay = nullptr;
     _pausedText = nullptr;
     _questionButton = nullptr;
     _returnButton = nullptr;
+    _instructionLayer = nullptr;
     _instructionOverlay = nullptr;
     _instructionImage = nullptr;
     _scene = nullptr;
     _assets = nullptr;
 }
 
-bool PolarPairsController::init(const std::shared_ptr<cugl::AssetManager>& assets, const cugl::Size& size) {
+bool PolarPairsController::init(const std::shared_ptr<cugl::AssetManager>& assets, const cugl::Size& size,
+                               const std::shared_ptr<cugl::graphics::SpriteBatch>& batch) {
     _assets = assets;
     if (!assets) return false;
     
@@ -58,13 +54,13 @@ bool PolarPairsController::init(const std::shared_ptr<cugl::AssetManager>& asset
 #else
     cugl::Input::activate<cugl::Mouse>();
 #endif
+    _swipes.init();
     
     // Create scene and initialize renderer
     _scene = cugl::scene2::Scene2::allocWithHint(size);
     if (!_scene) return false;
     
-    // Create a fresh sprite batch for this scene
-    auto batch = cugl::graphics::SpriteBatch::alloc();
+    // Draw with the application's sprite batch
     _scene->setSpriteBatch(batch);
     
     // Initialize the action timeline for animations
@@ -73,11 +69,8 @@ bool PolarPairsController::init(const std::shared_ptr<cugl::AssetManager>& asset
     _renderer.init(_scene, _assets);
     _renderer.setFrameTime(0.05f);  // Make animation faster (default is 0.12f)
     
-    // Initialize grid
-    _grid.clear();
-    for (int x = 0; x < GRID_WIDTH; x++) {
-        _grid.push_back(std::vector<int>(GRID_HEIGHT, 0));
-    }
+    // Resolve the sound effects once for the controller's lifetime
+    _sounds.init(_assets, "game.");
     
     // Initialize state variables
     _currentLevel = 1;
@@ -104,86 +97,96 @@ bool PolarPairsController::init(const std::shared_ptr<cugl::AssetManager>& asset
     _restartButtonOrigColor = cugl::Color4::WHITE;
     _pauseButtonOrigColor = cugl::Color4::WHITE;
     
-    // Load first level - this will create the buttons too
-    loadLevelData(_currentLevel);
+    // The HUD and menus are built once; switchLevel only swaps the board
+    buildHUD();
+    buildPauseMenu();
+    buildInstructions();
     
     return true;
 }
 
-void PolarPairsController::loadLevelData(int levelNum) {
+void PolarPairsController::loadLevelData(int levelNum, bool animated) {
     // Load level data
     LevelData levelData = LevelData::loadLevel(_assets, levelNum);
     _currentLevel = levelNum;
     
-    // First, completely clear the renderer to remove any old nodes
-    _renderer.clear();
-    
     // Reset game state
     _isMoving = false;
     _moveProgress = 0.0f;
+    _queuedMoves.clear();
+    _coopMoves.clear();
+    _swipes.reset();
+    if (_latency) _latency->cancelPending();
     _hasWon = false;
-    _bearMoves = 0;
-    _penguinMoves = 0;
-    _bearFinished = false;
-    _penguinFinished = false;
     _moveDirection = cugl::Vec2::ZERO;
     _blocksToBreak.clear();
+    _blocksToRemove.clear();
+    _winConditionMet = false;
+    _touchActive = false;
+    _levelTime = 0.0f;
     
-    // Set character positions
-    _polarBearGridPos = levelData.polarBearPos;
-    _penguinGridPos = levelData.penguinPos;
-    
-    // Set blocks
-    _bearBlocks = levelData.bearBlocks;
-    _penguinBlocks = levelData.penguinBlocks;
-    _breakableBlocks = levelData.breakableBlocks;
-    _bearFinishBlocks = levelData.bearFinishBlocks;
-    _penguinFinishBlocks = levelData.penguinFinishBlocks;
-    
-    // Reset grid
-    for (auto& column : _grid) std::fill(column.begin(), column.end(), 0);
-    
-    // Update grid with block positions - all in one loop
-    auto updateGrid = [&](const std::vector<cugl::Vec2>& blocks, int type) {
-        for (const auto& pos : blocks) {
-            if (pos.x >= 0 && pos.x < GRID_WIDTH && pos.y >= 0 && pos.y < GRID_HEIGHT) {
-                _grid[pos.x][pos.y] = type;
-            }
-        }
-    };
-    
-    // Set all blocks in grid with their types
-    updateGrid(levelData.blocks, 1);  // Regular obstacles (X)
-    updateGrid(levelData.invisibleBlocks, 7);
-    updateGrid(_bearBlocks, 2);
-    updateGrid(_penguinBlocks, 3);
-    updateGrid(_bearFinishBlocks, 4);
-    updateGrid(_penguinFinishBlocks, 5);
-    updateGrid(_breakableBlocks, 6);
-    
-    // Update the renderer
-    _renderer.drawGrid(_grid);
-    _renderer.updateCharacterPositions(_polarBearGridPos, _penguinGridPos);
-    
-    // Get the tile size from the renderer for button scaling
-    float tileSize = _renderer.getTileSize();
-    
-    // First remove any existing buttons
-    if (_restartButton && _restartButton->getParent()) {
-        _restartButton->getParent()->removeChild(_restartButton);
-        _restartButton = nullptr;
+    // Set character positions and blocks
+    _board.load(levelData);
+    
+    // Redraw only the cells that differ from the board on screen
+    _renderer.showGrid(_board.getGrid(), animated);
+    _renderer.updateCharacterPositions(_board.getBearPos(), _board.getPenguinPos());
+}
+
+void PolarPairsController::reloadLevel(const LevelData& levelData) {
+    if (_coop) {
+        // Only this copy would see the edit, putting the boards out of step
+        CULog("Level %d changed on disk; not reloaded during co-op", _currentLevel);
+        return;
     }
-    if (_pauseButton && _pauseButton->getParent()) {
-        _pauseButton->getParent()->removeChild(_pauseButton);
-        _pauseButton = nullptr;
+    auto start = std::chrono::steady_clock::now();
+    
+    // Drop the slide in progress; the board has not applied it yet
+    _isMoving = false;
+    _moveProgress = 0.0f;
+    _moveDirection = cugl::Vec2::ZERO;
+    _queuedMoves.clear();
+    _blocksToBreak.clear();
+    if (_latency) _latency->cancelPending();
+    
+    // A swipe begun on the old board starts over on the new one
+    _swipes.reset();
+    _touchActive = false;
+    _touchStart = cugl::Vec2::ZERO;
+    
+    // A win counting down is checked again against the edited board
+    _winConditionMet = false;
+    
+    _board.reload(levelData);
+    const std::vector<std::vector<int>>& grid = _board.getGrid();
+    
+    // Blocks still crumbling keep their timers only if they stay broken
+    _blocksToRemove.erase(std::remove_if(_blocksToRemove.begin(), _blocksToRemove.end(),
+                                         [&](const DelayedBlockRemoval& block) {
+                                             return grid[block.x][block.y] != 8;
+                                         }), _blocksToRemove.end());
+    
+    // Ease the edited cells in so the designer sees what changed
+    int counts[3] = { 0, 0, 0 };
+    for (const auto& change : _renderer.showGrid(grid, true)) {
+        counts[(int)change.kind]++;
     }
+    _renderer.updateCharacterPositions(_board.getBearPos(), _board.getPenguinPos());
     
-    // Create UI buttons
+    float millis = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    CULog("Reloaded level %d: %d added, %d removed, %d retyped in %.2f ms", _currentLevel,
+          counts[(int)GridDiff::Kind::ADD], counts[(int)GridDiff::Kind::REMOVE],
+          counts[(int)GridDiff::Kind::RETYPE], millis);
+}
+
+void PolarPairsController::buildHUD() {
+    // Create UI buttons, sized from the tile size every level is drawn at
     cugl::Size size = _scene->getSize();
+    float tileSize = calculateTileSize(size);
     
     // Create restart button with normal and pressed textures
-    std::shared_ptr<cugl::graphics::Texture> restartUp = _assets->get<cugl::graphics::Texture>("Restart");
-    std::shared_ptr<cugl::graphics::Texture> restartDown = _assets->get<cugl::graphics::Texture>("Restart_Pressed");
+    std::shared_ptr<cugl::graphics::Texture> restartUp = TextureAtlas::get(_assets, "Restart");
+    std::shared_ptr<cugl::graphics::Texture> restartDown = TextureAtlas::get(_assets, "Restart_Pressed");
     
     if (restartUp && restartDown) {
         _restartButton = cugl::scene2::Button::alloc(
@@ -191,9 +194,6 @@ void PolarPairsController::loadLevelData(int levelNum) {
             cugl::scene2::PolygonNode::allocWithTexture(restartDown)
         );
         
-        // Get tile size from renderer for scaling
-        float tileSize = _renderer.getTileSize();
-        
         // Calculate button scale based on tile size
         float buttonScale;
         if (tileSize > 0) {
@@ -213,19 +213,19 @@ void PolarPairsController::loadLevelData(int levelNum) {
         _restartButton->setName("restart");
         _restartButton->addListener([=] (const std::string& name, bool down) {
             if (down) {  // On press
-                playButtonPressSound(_assets);
+                _sounds.play(SoundEvents::Event::BUTTON);
             } else {  // On release
                 restartLevel();
             }
         });
         
-        _scene->addChild(_restartButton);
+        _renderer.getHUDLayer()->addChild(_restartButton);
         _restartButton->activate();
     }
     
     // Create pause button with normal and pressed textures
-    std::shared_ptr<cugl::graphics::Texture> pauseUp = _assets->get<cugl::graphics::Texture>("Pause");
-    std::shared_ptr<cugl::graphics::Texture> pauseDown = _assets->get<cugl::graphics::Texture>("Pause_Pressed");
+    std::shared_ptr<cugl::graphics::Texture> pauseUp = TextureAtlas::get(_assets, "Pause");
+    std::shared_ptr<cugl::graphics::Texture> pauseDown = TextureAtlas::get(_assets, "Pause_Pressed");
     
     if (pauseUp && pauseDown) {
         _pauseButton = cugl::scene2::Button::alloc(
@@ -251,19 +251,19 @@ void PolarPairsController::loadLevelData(int levelNum) {
         _pauseButton->setName("pause");
         _pauseButton->addListener([=] (const std::string& name, bool down) {
             if (down) {  // On press
-                playButtonPressSound(_assets);
+                _sounds.play(SoundEvents::Event::BUTTON);
             } else {  // On release
                 togglePause();
             }
         });
         
-        _scene->addChild(_pauseButton);
+        _renderer.getHUDLayer()->addChild(_pauseButton);
         _pauseButton->activate();
     }
     
     // Create question button (for instructions)
-    std::shared_ptr<cugl::graphics::Texture> questionUp = _assets->get<cugl::graphics::Texture>("Question_Up");
-    std::shared_ptr<cugl::graphics::Texture> questionDown = _assets->get<cugl::graphics::Texture>("Question_Down");
+    std::shared_ptr<cugl::graphics::Texture> questionUp = TextureAtlas::get(_assets, "Question_Up");
+    std::shared_ptr<cugl::graphics::Texture> questionDown = TextureAtlas::get(_assets, "Question_Down");
     
     if (questionUp && questionDown) {
         _questionButton = cugl::scene2::Button::alloc(
@@ -289,21 +289,57 @@ void PolarPairsController::loadLevelData(int levelNum) {
         _questionButton->setName("question");
         _questionButton->addListener([=] (const std::string& name, bool down) {
             if (down) {  // On press
-                playButtonPressSound(_assets);
+                _sounds.play(SoundEvents::Event::BUTTON);
             } else {  // On release
                 showInstructions();
             }
         });
         
-        _scene->addChild(_questionButton);
+        _renderer.getHUDLayer()->addChild(_questionButton);
         _questionButton->activate();
     }
+    
 }
 
 void PolarPairsController::switchLevel(int levelNum) {
-
+    // Start from a clean HUD in case the last level was left from a menu
+    forceCleanupAllUIElements();
+    _shouldExitToMenu = false;
+    
     //load the actual requested level
     loadLevelData(levelNum);
+    LevelManager::getInstance()->getStats().record(levelNum, StatsLog::Event::START);
+    _attemptOpen = true;
+    if (_restartButton) _restartButton->setVisible(!_coop);
+}
+
+void PolarPairsController::deactivate() {
+    // Leaving before the win counts as a quit
+    if (_attemptOpen) {
+        LevelManager::getInstance()->getStats().record(_currentLevel, StatsLog::Event::QUIT, 0, _levelTime,
+                                                       _board.getBearMoves() + _board.getPenguinMoves());
+        _attemptOpen = false;
+    }
+    
+    // The controller is reused, so each level gets its own sound report
+    if (_sounds.hasReport()) {
+        CULog("Level %d %s", _currentLevel, _sounds.getReport().c_str());
+        _sounds.resetReport();
+    }
+    
+    if (_restartButton) _restartButton->deactivate();
+    if (_pauseButton) _pauseButton->deactivate();
+    if (_questionButton) _questionButton->deactivate();
+    if (_resumeButton) _resumeButton->deactivate();
+    if (_exitButton) _exitButton->deactivate();
+    if (_returnButton) _returnButton->deactivate();
+}
+
+bool PolarPairsController::isAnimating() const {
+    // Anything here changes the screen on the next update
+    return _isMoving || _isFading || _touchActive || _winConditionMet ||
+           !_blocksToBreak.empty() || !_blocksToRemove.empty() ||
+           _renderer.isAnimating();
 }
 
 void PolarPairsController::update(float timestep) {
@@ -311,6 +347,24 @@ void PolarPairsController::update(float timestep) {
     if (_timeline) {
         _timeline->update(timestep);
     }
+    _sounds.update(timestep);
+    
+    // Co-op frames keep running through menus; the other player is still playing
+    if (_coop) {
+        _coop->update(timestep);
+        if (_coop->takeRestart()) {
+            // The other player started the level over; follow from frame 0
+            loadLevelData(_currentLevel);
+        }
+        LockstepSession::Step step;
+        while (_coop->pop(step)) {
+            queueCoopStep(step);
+        }
+    }
+    
+    if (_attemptOpen && !_isPaused && !_isShowingInstructions) {
+        _levelTime += timestep;
+    }
     
     // Check if win condition was met and we're waiting for animation to finish
     if (_winConditionMet) {
@@ -368,106 +422,36 @@ void PolarPairsController::update(float timestep) {
             _isFading = false;
             _fadeTime = 0;
             
-            if (!_isFadingIn) {
-                // Fade out complete - actually remove UI elements
-                if (!_isPaused) {
-                    // Remove pause menu elements
-                    if (_pauseOverlay) {
-                        _scene->removeChild(_pauseOverlay);
-                        _pauseOverlay = nullptr;
-                    }
-                    
-                    if (_resumeButton) {
-                        _resumeButton->deactivate();
-                        _scene->removeChild(_resumeButton);
-                        _resumeButton = nullptr;
-                    }
-                    
-                    if (_exitButton) {
-                        _exitButton->deactivate();
-                        _scene->removeChild(_exitButton);
-                        _exitButton = nullptr;
-                    }
-                    
-                    if (_pausedText) {
-                        _scene->removeChild(_pausedText);
-                        _pausedText = nullptr;
-                    }
-                }
-                
-                if (!_isShowingInstructions) {
-                    // Remove instruction elements
-                    if (_instructionOverlay) {
-                        _scene->removeChild(_instructionOverlay);
-                        _instructionOverlay = nullptr;
-                    }
-                    
-                    if (_instructionImage) {
-                        _scene->removeChild(_instructionImage);
-                        _instructionImage = nullptr;
-                    }
-                    
-                    if (_returnButton) {
-                        _returnButton->deactivate();
-                        _scene->removeChild(_returnButton);
-                        _returnButton = nullptr;
-                    }
-                }
-                
-                // Re-enable gameplay buttons if we're not in either menu
-                if (!_isPaused && !_isShowingInstructions) {
-                    if (_restartButton) _restartButton->activate();
-                    if (_pauseButton) _pauseButton->activate();
-                    if (_questionButton) _questionButton->activate();
-                }
-            } else {
+            if (_isFadingIn) {
                 // Fade in complete - fully opaque
-                if (_isPaused) {
-                    if (_pauseOverlay) _pauseOverlay->setColor(cugl::Color4(0, 0, 0, 192));
-                    if (_pausedText) _pausedText->setColor(cugl::Color4(255, 255, 255, 255));
-                    if (_resumeButton) _resumeButton->setColor(cugl::Color4(255, 255, 255, 255));
-                    if (_exitButton) _exitButton->setColor(cugl::Color4(255, 255, 255, 255));
-                } else if (_isShowingInstructions) {
-                    if (_instructionOverlay) _instructionOverlay->setColor(cugl::Color4(0, 0, 0, 192));
-                    if (_instructionImage) _instructionImage->setColor(cugl::Color4(255, 255, 255, 255));
-                    if (_returnButton) _returnButton->setColor(cugl::Color4(255, 255, 255, 255));
-                }
+                if (_isPaused && _pauseLayer) _pauseLayer->setColor(cugl::Color4::WHITE);
+                if (_isShowingInstructions && _instructionLayer) _instructionLayer->setColor(cugl::Color4::WHITE);
             }
-        } else {
-            // Update transparency based on animation progress
-            if (_isFadingIn) {
-                // Fading in - increase alpha
-                int alpha = (int)(192 * progress);
-                int textAlpha = (int)(255 * progress);
-                
-                if (_isPaused) {
-                    if (_pauseOverlay) _pauseOverlay->setColor(cugl::Color4(0, 0, 0, alpha));
-                    if (_pausedText) _pausedText->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                    if (_resumeButton) _resumeButton->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                    if (_exitButton) _exitButton->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                } else if (_isShowingInstructions) {
-                    if (_instructionOverlay) _instructionOverlay->setColor(cugl::Color4(0, 0, 0, alpha));
-                    if (_instructionImage) _instructionImage->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                    if (_returnButton) _returnButton->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                }
-            } else {
-                // Fading out - decrease alpha
-                int alpha = (int)(192 * (1.0f - progress));
-                int textAlpha = (int)(255 * (1.0f - progress));
-                
-                if (!_isPaused) {
-                    if (_pauseOverlay) _pauseOverlay->setColor(cugl::Color4(0, 0, 0, alpha));
-                    if (_pausedText) _pausedText->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                    if (_resumeButton) _resumeButton->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                    if (_exitButton) _exitButton->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                }
-                
-                if (!_isShowingInstructions) {
-                    if (_instructionOverlay) _instructionOverlay->setColor(cugl::Color4(0, 0, 0, alpha));
-                    if (_instructionImage) _instructionImage->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                    if (_returnButton) _returnButton->setColor(cugl::Color4(255, 255, 255, textAlpha));
-                }
+            
+            // Detach the menus that are no longer showing, keeping them for the next time they open
+            if (!_isPaused && _pauseLayer && _pauseLayer->getParent()) {
+                if (_resumeButton) _resumeButton->deactivate();
+                if (_exitButton) _exitButton->deactivate();
+                _pauseLayer->removeFromParent();
+            }
+            if (!_isShowingInstructions && _instructionLayer && _instructionLayer->getParent()) {
+                if (_returnButton) _returnButton->deactivate();
+                _instructionLayer->removeFromParent();
             }
+            
+            // Re-enable gameplay buttons if we're not in either menu
+            if (!_isFadingIn && !_isPaused && !_isShowingInstructions) {
+                if (_restartButton) _restartButton->activate();
+                if (_pauseButton) _pauseButton->activate();
+                if (_questionButton) _questionButton->activate();
+            }
+        } else {
+            // Each menu fades as a group: its layer's color tints every node
+            // in it, so a frame of fading is one color change per menu
+            float opacity = _isFadingIn ? progress : 1.0f - progress;
+            cugl::Color4 tint(255, 255, 255, (int)(255 * opacity));
+            if (_pauseLayer && _isPaused == _isFadingIn) _pauseLayer->setColor(tint);
+            if (_instructionLayer && _isShowingInstructions == _isFadingIn) _instructionLayer->setColor(tint);
         }
     }
     
@@ -477,74 +461,92 @@ void PolarPairsController::update(float timestep) {
     } else if (_isShowingInstructions && !_isFading) {
         processInstructionsInput();
     } else if (!_isPaused && !_isShowingInstructions && !_isFading) {
-        // Only process gameplay when not in a menu
-        if (!_isMoving) {
-            processInput();
-        } else {
+        // Only process gameplay when not in a menu. Input is read every
+        // frame so swipes made during a slide are queued, not dropped
+        processInput();
+        if (_isMoving) {
             // Update character movement
             updateMovement(timestep);
         }
         
+        // Start the next queued move as soon as the last one resolves
+        if (!_isMoving && !_coopMoves.empty()) {
+            CoopMove move = _coopMoves.front();
+            _coopMoves.pop_front();
+            if (_winConditionMet || _hasWon) {
+                _coopMoves.clear();
+            } else {
+                moveCharacters(move.direction, move.bear, move.penguin);
+            }
+        }
+        if (!_isMoving && !_queuedMoves.empty()) {
+            cugl::Vec2 direction = _queuedMoves.front();
+            _queuedMoves.pop_front();
+            if (_winConditionMet || _hasWon) {
+                _queuedMoves.clear();
+                if (_latency) _latency->cancelPending();
+            } else {
+                moveCharacters(direction);
+            }
+        }
+        
         // Update breaking blocks regardless of movement state
         updateBlockBreaking(timestep);
     }
 }
 
 void PolarPairsController::updateMovement(float timestep) {
+    // Character nodes change this frame
+    if (_latency) _latency->markMoved();
+    
     // Movement speed in grid cells per second
     float cellsPerSecond = 15.0f;
     
+    // Hurry the slide along when the player has already swiped again
+    if (_fastForward && (!_queuedMoves.empty() || !_coopMoves.empty())) {
+        cellsPerSecond *= FAST_FORWARD_SCALE;
+    }
+    
     // Progress movement based on total distance
     _moveProgress += (cellsPerSecond * timestep) / _totalTravelDistance;
     
     if (_moveProgress >= 1.0f) {
-        // Movement complete
-        if (!_bearFinished) {
-            _polarBearGridPos = _polarBearTarget;
-        }
-        if (!_penguinFinished) {
-            _penguinGridPos = _penguinTarget;
-        }
-        _renderer.updateCharacterPositions(_polarBearGridPos, _penguinGridPos);
-        
-        // Check if characters actually moved
-        bool bearMoved = _polarBearGridPos != _polarBearPrevPos;
-        bool penguinMoved = _penguinGridPos != _penguinPrevPos;
-        
-        // Check if both characters reached their destinations at the same time
-        if (bearMoved && penguinMoved) {
-            float bearDistance = (_polarBearTarget - _polarBearPrevPos).length();
-            float penguinDistance = (_penguinTarget - _penguinPrevPos).length();
-            
-            // Both characters moved a significant distance in the same move
-            if (bearDistance > 0.01f && penguinDistance > 0.01f) {
-                _simultaneousDestinationReached = true;
-                CULog("Both characters moved to destinations simultaneously!");
-            }
+        // Movement complete: positions, move counts, broken blocks and finish states
+        PuzzleBoard::Result result = _board.apply(_move);
+        _renderer.updateCharacterPositions(_board.getBearPos(), _board.getPenguinPos());
+        if (result.together) {
+            CULog("Both characters moved to destinations simultaneously!");
         }
         
-        // Increment move counters if characters actually moved
-        if (bearMoved) _bearMoves++;
-        if (penguinMoved) _penguinMoves++;
-        
         // Reset movement state
         _isMoving = false;
         _moveDirection = cugl::Vec2::ZERO;
         _moveProgress = 0.0f;
         
-        // Check win and finish conditions
-        updateFinishState();
+        // If a character just reached its finish block, play the sound and start animation
+        if (result.bearArrived) {
+            _sounds.play(SoundEvents::Event::FINISH_BLOCK);
+            _renderer.startFinishBlockAnimation(_board.getBearPos().x, _board.getBearPos().y, true);
+        }
+        if (result.penguinArrived) {
+            _sounds.play(SoundEvents::Event::FINISH_BLOCK);
+            _renderer.startFinishBlockAnimation(_board.getPenguinPos().x, _board.getPenguinPos().y, false);
+        }
+        
+        // Check win condition
         checkWinCondition();
     } else {
         // Calculate individual progress values for each character
-        float bearProgress = _bearFinished ? 1.0f : 
+        float bearProgress = _board.isBearFinished() ? 1.0f : 
             (_bearTravelDistance > 0 ? std::min(1.0f, (_moveProgress * _totalTravelDistance) / _bearTravelDistance) : 1.0f);
-        float penguinProgress = _penguinFinished ? 1.0f :
+        float penguinProgress = _board.isPenguinFinished() ? 1.0f :
             (_penguinTravelDistance > 0 ? std::min(1.0f, (_moveProgress * _totalTravelDistance) / _penguinTravelDistance) : 1.0f);
         
         // Interpolate positions based on individual progress
-        cugl::Vec2 bearPos = _polarBearPrevPos + (_polarBearTarget - _polarBearPrevPos) * bearProgress;
-        cugl::Vec2 penguinPos = _penguinPrevPos + (_penguinTarget - _penguinPrevPos) * penguinProgress;
+        const cugl::Vec2& bearStart = _board.getBearPos();
+        const cugl::Vec2& penguinStart = _board.getPenguinPos();
+        cugl::Vec2 bearPos = bearStart + (_move.bearTarget - bearStart) * bearProgress;
+        cugl::Vec2 penguinPos = penguinStart + (_move.penguinTarget - penguinStart) * penguinProgress;
         
         // Update renderer with interpolated positions
         _renderer.updateCharacterPositions(bearPos, penguinPos);
@@ -552,12 +554,12 @@ void PolarPairsController::updateMovement(float timestep) {
 }
 
 void PolarPairsController::processInput() {
-    // Only process input if we're not already moving
-    if (_isMoving) return;
-    
     // TOUCH HANDLING for gameplay swipes
     auto touch = cugl::Input::get<cugl::Touchscreen>();
     if (touch) {
+        // Swipes commit while the finger is still moving, not on release
+        cugl::Vec2 swipe = _swipes.update(touch);
+        
         // Check current touch state
         bool hasTouchNow = (touch->touchCount() > 0);
         
@@ -565,7 +567,8 @@ void PolarPairsController::processInput() {
         if (hasTouchNow) {
             auto& touchSet = touch->touchSet();
             if (!touchSet.empty()) {
-                cugl::TouchID tid = *(touchSet.begin());
+                // Follow the swiping finger, not whichever the set lists first
+                cugl::TouchID tid = _swipes.isTracking() ? _swipes.getTouch() : *(touchSet.begin());
                 cugl::Vec2 currentPos = touch->touchPosition(tid);
                 
                 // Convert touch coordinates to scene space
@@ -586,14 +589,9 @@ void PolarPairsController::processInput() {
                     // Handle resume button
                     if (_resumeButton) {
                         cugl::Rect resumeBounds = _resumeButton->getBoundingBox();
-                        CULog("Resume button bounds: (%f, %f) to (%f, %f)", 
-                            resumeBounds.origin.x, resumeBounds.origin.y,
-                            resumeBounds.origin.x + resumeBounds.size.width, 
-                            resumeBounds.origin.y + resumeBounds.size.height);
                         
                         // Check if touch is over resume button and update button state
                         if (resumeBounds.contains(scenePos)) {
-                            CULog("Touch is over resume button");
                             _resumeButton->setDown(touch->touchDown(tid));
                         } else {
                             _resumeButton->setDown(false);
@@ -603,14 +601,9 @@ void PolarPairsController::processInput() {
                     // Handle exit button
                     if (_exitButton) {
                         cugl::Rect exitBounds = _exitButton->getBoundingBox();
-                        CULog("Exit button bounds: (%f, %f) to (%f, %f)", 
-                            exitBounds.origin.x, exitBounds.origin.y,
-                            exitBounds.origin.x + exitBounds.size.width, 
-                            exitBounds.origin.y + exitBounds.size.height);
                         
                         // Check if touch is over exit button and update button state
                         if (exitBounds.contains(scenePos)) {
-                            CULog("Touch is over exit button");
                             _exitButton->setDown(touch->touchDown(tid));
                         } else {
                             _exitButton->setDown(false);
@@ -639,7 +632,6 @@ void PolarPairsController::processInput() {
                         
                         // Check if touch is over return button and update button state
                         if (returnBounds.contains(scenePos)) {
-                            CULog("Touch is over return button");
                             _returnButton->setDown(touch->touchDown(tid));
                         } else {
                             _returnButton->setDown(false);
@@ -678,12 +670,16 @@ void PolarPairsController::processInput() {
                         overButton = true;
                         // Let the button handle its own state
                         _questionButton->setDown(touch->touchDown(tid));
-                        CULog("Touch is over question button: %d", touch->touchDown(tid));
                     } else {
                         _questionButton->setDown(false);
                     }
                 }
                 
+                // A finger that lands on a button does not swipe
+                if (overButton && _swipes.justStarted()) {
+                    _swipes.cancel();
+                }
+                
                 // Only process game input if not over a button
                 if (!overButton) {
                     // If this is a new touch (wasn't active last frame)
@@ -760,103 +756,42 @@ void PolarPairsController::processInput() {
                 }
             }
             
-        // If touch ended, check for swipe
-            if (_touchActive) {
-            cugl::Vec2 delta = _lastTouchPos - _touchStart;
-            float length = delta.length();
-            
-            // Minimum swipe threshold
-            if (length >= 15.0f) {
-                    // Normalize delta to get direction
-                    delta.normalize();
-                    
-                    // Determine dominant direction
-                    if (std::abs(delta.x) > std::abs(delta.y)) {
-                    // Horizontal swipe
-                        if (delta.x > 0) moveCharacters(cugl::Vec2(1, 0));
-                        else moveCharacters(cugl::Vec2(-1, 0));
-                } else {
-                        // Vertical swipe - reversed direction
-                        if (delta.y > 0) moveCharacters(cugl::Vec2(0, 1)); // Down swipe
-                        else moveCharacters(cugl::Vec2(0, -1)); // Up swipe
-                    }
-            }
-            
-            // Reset touch state
+            // Touch ended; any swipe was already committed by the recognizer
             _touchActive = false;
         }
-    }
+        
+        if (swipe != cugl::Vec2::ZERO && !_isPaused && !_isShowingInstructions) {
+            queueMove(swipe);
+        }
     }
 }
 
 void PolarPairsController::checkWinCondition() {
-    if (_bearFinished && _penguinFinished && !_winConditionMet) {
+    if (_board.isWon() && !_winConditionMet) {
         // Play level complete sound
-        auto levelCompleteSound = _assets->get<cugl::audio::Sound>("levelCompleteSound");
-        if (levelCompleteSound) {
-            cugl::audio::AudioEngine::get()->play("levelComplete", levelCompleteSound, false, 0.8f);
-        }
-        
-        // Initialize score to 0
-        int score = 0;
-        
-        // Get the target bear and seal step counts from the level file
-        std::string assetDir = cugl::Application::get()->getAssetDirectory();
-        std::string levelPath = assetDir + "levels/level" + std::to_string(_currentLevel) + ".txt";
-        
-        int targetBearSteps = 0;
-        int targetSealSteps = 0;
-        
-        std::ifstream file(levelPath);
-        if (file.is_open()) {
-            std::string line;
-            int lineNumber = 0;
-            
-            while (std::getline(file, line) && lineNumber <= 14) {
-                lineNumber++;
-                
-                // Line 12 contains target bear steps
-                if (lineNumber == 14) {
-                    std::istringstream iss(line);
-                    iss >> targetBearSteps;
-                }
-                
-                // Line 13 contains target seal steps
-                if (lineNumber == 15) {
-                    std::istringstream iss(line);
-                    iss >> targetSealSteps;
-                }
-            }
-            file.close();
-        }
+        _sounds.play(SoundEvents::Event::LEVEL_COMPLETE);
         
+        // The target bear and seal step counts come from the level file
         CULog("Bear moves: %d (target: %d), Seal moves: %d (target: %d)", 
-              _bearMoves, targetBearSteps, _penguinMoves, targetSealSteps);
-        
-        // Score +1 if bear takes less steps than target
-        if (_bearMoves <= targetBearSteps) {
-            score += 1;
-        }
-        
-        // Score +1 if seal takes less steps than target
-        if (_penguinMoves <= targetSealSteps) {
-            score += 1;
-        }
-        
-        // Add third point if both characters reached destination at the same time
-        // This is now handled during movement in updateMovement()
-        if (_simultaneousDestinationReached) {
-            score += 1;
+              _board.getBearMoves(), _board.getBearPar(), _board.getPenguinMoves(), _board.getPenguinPar());
+        if (_board.isTogether()) {
             CULog("Both characters reached destinations simultaneously! +1 point");
         }
-        
-        // Ensure score is between 0 and 3
-        score = std::max(0, std::min(score, 3));
+        int score = _board.getScore();
         
         // Save the score and unlock next level
         LevelManager::getInstance()->setLevelScore(_currentLevel, score);
         LevelManager::getInstance()->unlockLevel(_currentLevel + 1);
         
+        StatsLog& stats = LevelManager::getInstance()->getStats();
+        stats.record(_currentLevel, StatsLog::Event::WIN, score, _levelTime,
+                     _board.getBearMoves() + _board.getPenguinMoves());
+        _attemptOpen = false;
+        CULog("Level %d solved in %.1f s (best %.1f s)", _currentLevel, _levelTime, stats.getBestTime(_currentLevel));
+        if (_coop) {
+            CULog("%s", _coop->getReport().c_str());
+        }
+        
         // Set win condition flag and delay
         _winConditionMet = true;
         _winDelay = 0.7f; // Wait 0.7 seconds before transitioning to win scene
@@ -865,387 +800,93 @@ void PolarPairsController::checkWinCondition() {
     }
 }
 
-// --- Main movement and squeeze logic ---
-void PolarPairsController::moveCharacters(const cugl::Vec2& direction) {
-    if (!_isMoving && direction != cugl::Vec2::ZERO) {
-        _moveDirection = direction;
-        _isMoving = true;
-        
-        // Calculate targets first to determine if a squeeze will occur
-        calculateMovementTargets();
-        
-        // If a squeeze occurred, trigger bounce animation for the character being pushed (moving opposite to input direction)
-        if (_squeezeJustOccurred) {
-            _renderer.startCharacterBounceAnimation(_bearIsBeingPushed);
-        }
-        
-        // Check if movement was blocked (targets equal current positions)
-        if (_polarBearTarget == _polarBearGridPos && _penguinTarget == _penguinGridPos) {
-            // Play the blocked sound
-            auto blockedSound = _assets->get<cugl::audio::Sound>("blockedSound");
-            if (blockedSound) {
-                cugl::audio::AudioEngine::get()->play("blocked", blockedSound, false, 0.8f);
-            }
-            
-            // Trigger the blocked animation
-            _renderer.startBlockedAnimation(_moveDirection);
-        } else if (!_squeezeJustOccurred) {
-            // Play move sound ONLY if not a squeeze (squeeze sound is played in calculateMovementTargets)
-            auto moveSound = _assets->get<cugl::audio::Sound>("moveSound");
-            if (moveSound) {
-                cugl::audio::AudioEngine::get()->play("move", moveSound, false, 0.8f);
-            }
-        }
-        // Note: The squeeze sound is already played in calculateMovementTargets when _squeezeJustOccurred becomes true
-    }
-}
-
-void PolarPairsController::calculateMovementTargets() {
-    // Store previous positions before calculating targets
-    _polarBearPrevPos = _polarBearGridPos;
-    _penguinPrevPos = _penguinGridPos;
-    
-    // Initialize targets to current positions
-    _polarBearTarget = _polarBearGridPos;
-    _penguinTarget = _penguinGridPos;
-    
-    // If both characters are on their finish blocks, don't calculate new targets
-    if (_bearFinished && _penguinFinished) {
-        _isMoving = false;
-        _moveDirection = cugl::Vec2::ZERO;
-        _moveProgress = 0.0f;
+void PolarPairsController::queueMove(const cugl::Vec2& direction) {
+    if (_coop) {
+        // The swipe runs when its lockstep frame comes round on both devices
+        _coop->submit(LockstepSession::encodeDirection((int)direction.x, (int)direction.y));
         return;
     }
-    
-    // Check for squeeze first - handles a special movement case
-    _squeezeJustOccurred = checkForSqueeze();
-    
-    if (_squeezeJustOccurred) {
-        // Play squeeze sound
-        auto squeezeSound = _assets->get<cugl::audio::Sound>("squeezeSound");
-        if (squeezeSound) {
-            cugl::audio::AudioEngine::get()->play("squeeze", squeezeSound, false, 0.8f);
-        }
-        
-        // Squeeze mechanics: rear character pushes front character in opposite direction
-        bool bearFront = !_polarBearIsRear;
-        
-        // The bear is the one moving in the opposite direction if it's the front character
-        _bearIsBeingPushed = bearFront;
-        
-        // Calculate movements for front and rear characters
-        cugl::Vec2 frontStart = bearFront ? _polarBearGridPos : _penguinGridPos;
-        cugl::Vec2 rearStart = bearFront ? _penguinGridPos : _polarBearGridPos;
-        bool frontIsPenguin = !bearFront;
-        
-        // Calculate slide targets
-        cugl::Vec2 frontTarget = slide(frontStart, frontIsPenguin, true, -_moveDirection);
-        cugl::Vec2 rearTarget = slide(rearStart, !frontIsPenguin, true, _moveDirection);
-        
-        // Assign targets based on finish state
-        if (bearFront) {
-            if (!_bearFinished) _polarBearTarget = frontTarget;
-            if (!_penguinFinished) _penguinTarget = rearTarget;
-        } else {
-            if (!_penguinFinished) _penguinTarget = frontTarget;
-            if (!_bearFinished) _polarBearTarget = rearTarget;
-        }
-    } else {
-        // Standard movement: determine which character is in front
-        bool bearInFront = false;
-        if (_moveDirection.x != 0) {
-            bearInFront = (_moveDirection.x > 0) ? 
-                          (_polarBearGridPos.x > _penguinGridPos.x) : 
-                          (_polarBearGridPos.x < _penguinGridPos.x);
-        } else {
-            bearInFront = (_moveDirection.y > 0) ? 
-                          (_polarBearGridPos.y > _penguinGridPos.y) : 
-                          (_polarBearGridPos.y < _penguinGridPos.y);
-        }
-        
-        // Calculate targets for front and rear characters
-        cugl::Vec2 frontPos = bearInFront ? _polarBearGridPos : _penguinGridPos;
-        cugl::Vec2 rearPos = bearInFront ? _penguinGridPos : _polarBearGridPos;
-        bool frontIsPenguin = !bearInFront;
-        
-        // Calculate front character target first
-        cugl::Vec2 frontTarget = frontPos;
-        if (!(_bearFinished && bearInFront) && !(_penguinFinished && !bearInFront)) {
-            frontTarget = computeTarget(frontPos, frontIsPenguin, false, _moveDirection, rearPos, NO_TARGET);
-            if (bearInFront) _polarBearTarget = frontTarget;
-            else _penguinTarget = frontTarget;
-        }
-        
-        // Now calculate rear character target using the UPDATED front target position
-        cugl::Vec2 frontCharacterNewPos = frontTarget;
-        if (!(_bearFinished && !bearInFront) && !(_penguinFinished && bearInFront)) {
-            cugl::Vec2 rearTarget = computeTarget(rearPos, !frontIsPenguin, false, _moveDirection, 
-                                                  frontCharacterNewPos, frontTarget);
-            if (bearInFront) _penguinTarget = rearTarget;
-            else _polarBearTarget = rearTarget;
-        }
-        
-        // Prevent character overlap
-        if (_polarBearTarget == _penguinTarget) {
-            if (bearInFront) _penguinTarget = _polarBearTarget - _moveDirection;
-            else _polarBearTarget = _penguinTarget - _moveDirection;
-        }
+    if (_queuedMoves.size() < MAX_QUEUED_MOVES) {
+        _queuedMoves.push_back(direction);
+        if (_latency) _latency->markRecognized();
     }
-    
-    // Calculate travel distances for smooth movement
-    _bearTravelDistance = (_polarBearTarget - _polarBearGridPos).length();
-    _penguinTravelDistance = (_penguinTarget - _penguinGridPos).length();
-    _totalTravelDistance = std::max(_bearTravelDistance, _penguinTravelDistance);
-    
-    // Reset movement progress
-    _moveProgress = 0;
 }
 
-cugl::Vec2 PolarPairsController::calculateSingleCharacterMove(const cugl::Vec2& start, bool isPenguin, const cugl::Vec2& direction) {
-    cugl::Vec2 curr = start;
-    cugl::Vec2 next = curr + direction;
-    
-    // Check boundary
-    if (next.x < 0 || next.x >= GRID_WIDTH || next.y < 0 || next.y >= GRID_HEIGHT) {
-        return curr;
-    }
-    
-    // Check cell type
-    int cell = _grid[next.x][next.y];
-    
-    // Check for obstacles
-    if (cell == 1 || cell == 7) { // Regular or invisible block
-        return curr;
-    }
-    
-    // Check for character-specific blocks
-    if (isPenguin) {
-        if (cell == 2 || cell == 4) { // Bear block or finish
-            return curr;
-        }
-    } else {
-        if (cell == 3 || cell == 5) { // Penguin block or finish
-            return curr;
-        }
+void PolarPairsController::queueCoopStep(const LockstepSession::Step& step) {
+    int x = 0;
+    int y = 0;
+    if (step.bear != LockstepSession::NO_INPUT && step.bear == step.penguin) {
+        // Both players swiped the same way on the same frame: one shared move
+        LockstepSession::decodeDirection(step.bear, x, y);
+        _coopMoves.push_back({ cugl::Vec2(x, y), true, true });
+        return;
     }
-    
-    // Handle breakable blocks
-    if (cell == 6) {
-        scheduleBlockBreaking(next.x, next.y, 0.2f);
+    if (step.bear != LockstepSession::NO_INPUT) {
+        LockstepSession::decodeDirection(step.bear, x, y);
+        _coopMoves.push_back({ cugl::Vec2(x, y), true, false });
     }
-    
-    // Check for other character
-    if (next == (isPenguin ? _polarBearGridPos : _penguinGridPos)) {
-        return curr;
+    if (step.penguin != LockstepSession::NO_INPUT) {
+        LockstepSession::decodeDirection(step.penguin, x, y);
+        _coopMoves.push_back({ cugl::Vec2(x, y), false, true });
     }
-    
-    return next;
 }
 
-// --- Squeeze logic ---
-bool PolarPairsController::checkForSqueeze() {
-    cugl::Vec2 diff = _polarBearGridPos - _penguinGridPos;
-    
-    // Quick check: must be adjacent and aligned with movement direction
-    if (diff.length() != 1.0f) return false;
-    
-    // Check alignment with movement in one step
-    bool isHorizontal = _moveDirection.x != 0;
-    if ((isHorizontal && diff.y != 0) || (!isHorizontal && diff.x != 0)) return false;
-    
-    // Determine which character is in front (simplified logic)
-    bool bearInFront = (isHorizontal ? 
-                       (_moveDirection.x * diff.x > 0) : 
-                       (_moveDirection.y * diff.y > 0));
-    
-    // Get front character position and next position in one step
-    cugl::Vec2 frontPos = bearInFront ? _polarBearGridPos : _penguinGridPos;
-    cugl::Vec2 frontNext = frontPos + _moveDirection;
-    
-    // Check boundary first (fastest check)
-    if (frontNext.x < 0 || frontNext.x >= GRID_WIDTH || 
-        frontNext.y < 0 || frontNext.y >= GRID_HEIGHT) {
-        // Only check special blocks if we would squeeze
-        if (checkNoSqueezeBlocks()) return false;
-        _polarBearIsRear = !bearInFront;
-        return true;
-    }
-    
-    // Check cell type
-    int cell = _grid[frontNext.x][frontNext.y];
-    bool blocked = (cell == 1 || cell == 7) || // Regular or invisible block
-                  (bearInFront && (cell == 3 || cell == 5)) || // Bear blocked by penguin tiles
-                  (!bearInFront && (cell == 2 || cell == 4)); // Penguin blocked by bear tiles
-    
-    if (cell == 6) { // Breakable block
-        scheduleBlockBreaking(frontNext.x, frontNext.y, 0.2f);
-        blocked = true;
-    }
-    
-    if (blocked) {
-        // Only check special blocks if we would squeeze
-        if (checkNoSqueezeBlocks()) return false;
-        _polarBearIsRear = !bearInFront;
-        return true;
-    }
-    
-    return false;
+void PolarPairsController::setCoop(LockstepSession* session) {
+    _coop = session;
+    _coopMoves.clear();
+    if (_restartButton) _restartButton->setVisible(!_coop);
 }
 
-// Helper function to check if either character is on their special blocks (passable or finish)
-bool PolarPairsController::checkNoSqueezeBlocks() {
-    int bearCell = _grid[_polarBearGridPos.x][_polarBearGridPos.y];
-    int penguinCell = _grid[_penguinGridPos.x][_penguinGridPos.y];
-    // Check both passable blocks (2,3) and finish blocks (4,5)
-    return (bearCell == 2 || bearCell == 4 || penguinCell == 3 || penguinCell == 5);
-}
-
-cugl::Vec2 PolarPairsController::slide(const cugl::Vec2& start, bool isPenguin, bool canBreak, const cugl::Vec2& direction) {
-    cugl::Vec2 curr = start;
-    
-    while (true) {
-        cugl::Vec2 next = curr + direction;
-        
-        // Check boundary
-        if (next.x < 0 || next.x >= GRID_WIDTH || next.y < 0 || next.y >= GRID_HEIGHT) break;
-        
-        // Check cell type
-        int cell = _grid[next.x][next.y];
-        if (cell == 1 || cell == 7) break; // Regular or invisible block
-        
-        // Block characters from entering wrong finish blocks or other character's blocks
-        if (isPenguin) {
-            if (cell == 2 || cell == 4) break; // Block penguin from bear blocks and bear finish
-        } else {
-            if (cell == 3 || cell == 5) break; // Block bear from penguin blocks and penguin finish
-        }
+// --- Main movement and squeeze logic ---
+void PolarPairsController::moveCharacters(const cugl::Vec2& direction, bool moveBear, bool movePenguin) {
+    if (!_isMoving && direction != cugl::Vec2::ZERO) {
+        // Nothing moves once both characters are home (or held in co-op)
+        bool bearFree = moveBear && !_board.isBearFinished();
+        bool penguinFree = movePenguin && !_board.isPenguinFinished();
+        _moveDirection = bearFree || penguinFree ? direction : cugl::Vec2::ZERO;
+        _isMoving = bearFree || penguinFree;
         
-        // Check if the next cell is a finish block for this character
-        bool isFinishBlock = false;
-        if (isPenguin) {
-            // Check if next is a penguin finish block
-            for (const auto& pos : _penguinFinishBlocks) {
-                if (next.x == pos.x && next.y == pos.y) {
-                    isFinishBlock = true;
-                    break;
-                }
-            }
-        } else {
-            // Check if next is a bear finish block
-            for (const auto& pos : _bearFinishBlocks) {
-                if (next.x == pos.x && next.y == pos.y) {
-                    isFinishBlock = true;
-                    break;
-                }
-            }
-        }
+        // Calculate targets first to determine if a squeeze will occur
+        _move = _board.plan(direction, moveBear, movePenguin);
         
-        // If moving to a finish block, move there and stop
-        if (isFinishBlock) {
-            curr = next;
-            break;
+        // If a squeeze occurred, trigger bounce animation for the character being pushed (moving opposite to input direction)
+        if (_move.squeeze) {
+            _sounds.play(SoundEvents::Event::SQUEEZE);
+            _renderer.startCharacterBounceAnimation(_move.bearPushed);
         }
         
-        if (cell == 6) { // Breakable block
-            if (canBreak) {
-                // Schedule block to break with a delay
-                scheduleBlockBreaking(next.x, next.y, 0.2f);
-                // Continue moving after breaking the block
-                curr = next;
-            } else {
-                curr = next; // allow moving into breakable block for check
-                break;
-            }
-        } else {
-            // Move to next position for non-breakable blocks
-            curr = next;
+        // Check if movement was blocked (targets equal current positions)
+        if (_move.bearTarget == _board.getBearPos() && _move.penguinTarget == _board.getPenguinPos()) {
+            // Play the blocked sound
+            _sounds.play(SoundEvents::Event::BLOCKED);
+            
+            // Trigger the blocked animation
+            _renderer.startBlockedAnimation(_moveDirection);
+        } else if (!_move.squeeze) {
+            // Play move sound ONLY if not a squeeze
+            _sounds.play(SoundEvents::Event::MOVE);
         }
-    }
-    
-    return curr;
-}
-
-cugl::Vec2 PolarPairsController::computeTarget(const cugl::Vec2& start, bool isPenguin, bool canBreak,
-                                       const cugl::Vec2& direction,
-                                       const cugl::Vec2& otherStart,
-                                       const cugl::Vec2& otherTarget) {
-    cugl::Vec2 curr = start;
-    
-    while (true) {
-        cugl::Vec2 next = curr + direction;
-        
-        // Check boundary
-        if (next.x < 0 || next.x >= GRID_WIDTH || next.y < 0 || next.y >= GRID_HEIGHT) break;
-        
-        // Check for other character's current or future position
-        if (next == otherTarget || (otherTarget == NO_TARGET && next == otherStart)) break;
         
-        // Check if characters are aligned on movement axis and would pass through each other
-        bool wouldPassThroughOther = false;
-        if (direction.x != 0) { // Horizontal movement
-            if (next.y == otherStart.y) { // Same row
-                // Check if we'd pass through the other character
-                if ((direction.x > 0 && curr.x < otherStart.x && next.x > otherStart.x) || 
-                    (direction.x < 0 && curr.x > otherStart.x && next.x < otherStart.x)) {
-                    wouldPassThroughOther = true;
-                }
-            }
-        } else if (direction.y != 0) { // Vertical movement
-            if (next.x == otherStart.x) { // Same column
-                // Check if we'd pass through the other character
-                if ((direction.y > 0 && curr.y < otherStart.y && next.y > otherStart.y) || 
-                    (direction.y < 0 && curr.y > otherStart.y && next.y < otherStart.y)) {
-                    wouldPassThroughOther = true;
-                }
-            }
+        // Cracked blocks break partway through the slide; the board breaks them when it ends
+        for (const auto& pos : _move.breaks) {
+            scheduleBlockBreaking(pos.x, pos.y, 0.2f);
         }
         
-        if (wouldPassThroughOther) break;
-        
-        // Check cell type
-        int cell = _grid[next.x][next.y];
-        if (cell == 1 || cell == 7) break; // Regular or invisible block
-        if (isPenguin && (cell == 2 || cell == 4)) break; // Bear block or finish
-        if (!isPenguin && (cell == 3 || cell == 5)) break; // Penguin block or finish
+        // Calculate travel distances for smooth movement
+        _bearTravelDistance = (_move.bearTarget - _board.getBearPos()).length();
+        _penguinTravelDistance = (_move.penguinTarget - _board.getPenguinPos()).length();
+        _totalTravelDistance = std::max(_bearTravelDistance, _penguinTravelDistance);
+        _moveProgress = 0;
         
-        // Check if the next cell is a finish block for this character
-        bool isFinishBlock = false;
-        if (isPenguin) {
-            // Check if next is a penguin finish block
-            for (const auto& pos : _penguinFinishBlocks) {
-                if (next.x == pos.x && next.y == pos.y) {
-                    isFinishBlock = true;
-                    break;
-                }
-            }
-        } else {
-            // Check if next is a bear finish block
-            for (const auto& pos : _bearFinishBlocks) {
-                if (next.x == pos.x && next.y == pos.y) {
-                    isFinishBlock = true;
-                    break;
-                }
+        if (_latency) {
+            if (_isMoving) {
+                _latency->markAccepted();
+            } else {
+                // Both characters are home; no swipe will move them now
+                _latency->cancelPending();
             }
         }
-        
-        // If moving to a finish block, move there and stop
-        if (isFinishBlock) {
-            curr = next;
-            break;
-        }
-        
-        if (cell == 6) { // Breakable block
-            if (canBreak) {
-                // Schedule block to break with a delay
-                scheduleBlockBreaking(next.x, next.y, 0.2f);
-            } else break;
-        }
-        
-        // Move to next position
-        curr = next;
     }
-    
-    return curr;
 }
 
 // Block breaking methods
@@ -1268,14 +909,8 @@ void PolarPairsController::updateBlockBreaking(float timestep) {
         it->delay -= timestep;
         
         if (it->delay <= 0) {
-            // Time to break the block
-            int x = it->position.x;
-            int y = it->position.y;
-            
-            // Only break if still a breakable block
-            if (x >= 0 && x < GRID_WIDTH && y >= 0 && y < GRID_HEIGHT && _grid[x][y] == 6) {
-                breakBlock(x, y);
-            }
+            // Time to show the block breaking; the board breaks it when the move ends
+            breakBlock(it->position.x, it->position.y);
             
             // Remove from our list and continue with next
             it = _blocksToBreak.erase(it);
@@ -1286,28 +921,8 @@ void PolarPairsController::updateBlockBreaking(float timestep) {
 }
 
 void PolarPairsController::breakBlock(int x, int y) {
-    // Remove from breakable blocks list - find and erase in one operation
-    auto it = std::find_if(_breakableBlocks.begin(), _breakableBlocks.end(),
-        [x, y](const cugl::Vec2& pos) {
-            return pos.x == x && pos.y == y;
-        });
-    
-    if (it != _breakableBlocks.end()) {
-        _breakableBlocks.erase(it);
-    }
-    
-    // Play ice break sound effect
-    auto iceBreakSound = _assets->get<cugl::audio::Sound>("iceBreakSound");
-    if (iceBreakSound) {
-        // Use the AudioEngine to play the sound
-        cugl::audio::AudioEngine::get()->play("iceBreak", iceBreakSound, false, 0.6f);
-    }
-    
-    // IMMEDIATELY update the grid to make the tile passable (type 8)
-    // This allows characters to move through it without waiting
-    if (x >= 0 && x < GRID_WIDTH && y >= 0 && y < GRID_HEIGHT && _grid[x][y] == 6) {
-        _grid[x][y] = 8;
-    }
+    // Play ice break sound effect; chained breaks share a few voices
+    _sounds.play(SoundEvents::Event::ICE_BREAK);
     
     // Start animation for the visual breaking effect
     _renderer.startBreakAnimation(x, y);
@@ -1323,67 +938,14 @@ void PolarPairsController::breakBlock(int x, int y) {
     _blocksToRemove.emplace_back(x, y, animationDuration);
 }
 
-void PolarPairsController::createMoveCounters() {
-    // Initialize move counts
-    _bearMoves = 0;
-    _penguinMoves = 0;
-    _bearFinished = false;
-    _penguinFinished = false;
-    _simultaneousDestinationReached = false;
-}
-
-void PolarPairsController::updateMoveCounters() {
-    // Log for debugging
-}
-
-void PolarPairsController::updateFinishState() {
-    // Check if bear is on finish
-    bool wasBearFinished = _bearFinished;
-    _bearFinished = false;
-    for (const auto& pos : _bearFinishBlocks) {
-        if (pos.x == _polarBearGridPos.x && pos.y == _polarBearGridPos.y) {
-            _bearFinished = true;
-            // If the bear just reached the finish block, play the sound and start animation
-            if (!wasBearFinished) {
-                auto finishBlockSound = _assets->get<cugl::audio::Sound>("finishBlockSound");
-                if (finishBlockSound) {
-                    cugl::audio::AudioEngine::get()->play("finishBlock", finishBlockSound, false, 1.0f);
-                }
-                
-                // Start the finish block animation
-                _renderer.startFinishBlockAnimation(pos.x, pos.y, true);
-            }
-            break;
-        }
-    }
-    
-    // Check if penguin is on finish
-    bool wasPenguinFinished = _penguinFinished;
-    _penguinFinished = false;
-    for (const auto& pos : _penguinFinishBlocks) {
-        if (pos.x == _penguinGridPos.x && pos.y == _penguinGridPos.y) {
-            _penguinFinished = true;
-            // If the penguin just reached the finish block, play the sound and start animation
-            if (!wasPenguinFinished) {
-                auto finishBlockSound = _assets->get<cugl::audio::Sound>("finishBlockSound");
-                if (finishBlockSound) {
-                    cugl::audio::AudioEngine::get()->play("finishBlock", finishBlockSound, false, 1.0f);
-                }
-                
-                // Start the finish block animation
-                _renderer.startFinishBlockAnimation(pos.x, pos.y, false);
-            }
-            break;
-        }
-    }
-    
-    // Update the move counters to reflect finish state
-    updateMoveCounters();
-}
-
 // Simple restart that preserves and reuses buttons
 void PolarPairsController::restartLevel() {
-    loadLevelData(_currentLevel);
+    if (_coop) {
+        return;
+    }
+    loadLevelData(_currentLevel, true);
+    LevelManager::getInstance()->getStats().record(_currentLevel, StatsLog::Event::RESTART);
+    _attemptOpen = true;
 }
 
 void PolarPairsController::togglePause() {
@@ -1396,52 +958,26 @@ void PolarPairsController::togglePause() {
     }
 }
 
-void PolarPairsController::showPauseMenu() {
-    if (_isPaused) {
-        return; // Already paused
-    }
-    
-    // If instructions are showing, hide them first
-    if (_isShowingInstructions) {
-        hideInstructions();
-    }
-    
-    _isPaused = true;
-    
-    // Clean up any existing elements first (just in case)
-    if (_pauseOverlay && _pauseOverlay->getParent()) {
-        _scene->removeChild(_pauseOverlay);
-        _pauseOverlay = nullptr;
-    }
-    if (_pausedText && _pausedText->getParent()) {
-        _scene->removeChild(_pausedText);
-        _pausedText = nullptr;
-    }
-    if (_resumeButton && _resumeButton->getParent()) {
-        _resumeButton->deactivate();
-        _scene->removeChild(_resumeButton);
-        _resumeButton = nullptr;
-    }
-    if (_exitButton && _exitButton->getParent()) {
-        _exitButton->deactivate();
-        _scene->removeChild(_exitButton);
-        _exitButton = nullptr;
+void PolarPairsController::buildPauseMenu() {
+    if (_pauseOverlay && _pausedText && _resumeButton && _exitButton) {
+        return; // Already built
     }
     
     // Create a semi-transparent overlay
     cugl::Size size = _scene->getSize();
     
-    _pauseOverlay = cugl::scene2::PolygonNode::alloc();
-    _pauseOverlay->setColor(cugl::Color4(0, 0, 0, 0)); // Start fully transparent
-    _pauseOverlay->setContentSize(size);
-    _pauseOverlay->setAnchor(cugl::Vec2::ANCHOR_CENTER);
-    _pauseOverlay->setPosition(size.width/2, size.height/2);
-    _pauseOverlay->setPriority(900); // Below buttons but above game
-    _scene->addChild(_pauseOverlay);
+    if (!_pauseOverlay) {
+        _pauseOverlay = cugl::scene2::PolygonNode::alloc();
+        _pauseOverlay->setColor(cugl::Color4(0, 0, 0, 192));
+        _pauseOverlay->setContentSize(size);
+        _pauseOverlay->setAnchor(cugl::Vec2::ANCHOR_CENTER);
+        _pauseOverlay->setPosition(size.width/2, size.height/2);
+        _pauseOverlay->setPriority(900); // Below buttons but above game
+    }
     
     // Create paused text
-    std::shared_ptr<cugl::graphics::Texture> pausedTexture = _assets->get<cugl::graphics::Texture>("Paused");
-    if (pausedTexture) {
+    std::shared_ptr<cugl::graphics::Texture> pausedTexture = TextureAtlas::get(_assets, "Paused");
+    if (pausedTexture && !_pausedText) {
         _pausedText = cugl::scene2::PolygonNode::allocWithTexture(pausedTexture);
         
         // Use our helper method to calculate tile size
@@ -1453,16 +989,12 @@ void PolarPairsController::showPauseMenu() {
         _pausedText->setAnchor(cugl::Vec2::ANCHOR_CENTER);
         _pausedText->setPosition(size.width * PAUSED_TEXT_X, size.height * PAUSED_TEXT_Y);
         _pausedText->setPriority(1001);
-        _pausedText->setColor(cugl::Color4(255, 255, 255, 0)); // Start transparent
-    }
-    if (_pausedText) {
-        _scene->addChild(_pausedText);
     }
     
     // Create resume button in the same position as the pause button
     if (!_resumeButton) {
-        std::shared_ptr<cugl::graphics::Texture> resumeUp = _assets->get<cugl::graphics::Texture>("Resume_Up");
-        std::shared_ptr<cugl::graphics::Texture> resumeDown = _assets->get<cugl::graphics::Texture>("Resume_Down");
+        std::shared_ptr<cugl::graphics::Texture> resumeUp = TextureAtlas::get(_assets, "Resume_Up");
+        std::shared_ptr<cugl::graphics::Texture> resumeDown = TextureAtlas::get(_assets, "Resume_Down");
         
         if (resumeUp && resumeDown) {
             _resumeButton = cugl::scene2::Button::alloc(
@@ -1498,7 +1030,6 @@ void PolarPairsController::showPauseMenu() {
             }
             
             _resumeButton->setPriority(1001);
-            _resumeButton->setColor(cugl::Color4(255, 255, 255, 0)); // Start transparent
             
             // Add button listener using direct callback function
             _resumeButton->setName("resume");
@@ -1510,7 +1041,7 @@ void PolarPairsController::showPauseMenu() {
                 _resumeButton->setDown(down);
                 
                 if (down) {  // On press
-                    playButtonPressSound(_assets);
+                    _sounds.play(SoundEvents::Event::BUTTON);
                 } else {  // On release
                     // Deactivate the button immediately to prevent multiple clicks
                     _resumeButton->deactivate();
@@ -1521,13 +1052,11 @@ void PolarPairsController::showPauseMenu() {
             });
         }
     }
-    _scene->addChild(_resumeButton);
-    _resumeButton->activate();
     
     // Create exit button in the same position as the restart button
     if (!_exitButton) {
-        std::shared_ptr<cugl::graphics::Texture> exitUp = _assets->get<cugl::graphics::Texture>("Exit_Up");
-        std::shared_ptr<cugl::graphics::Texture> exitDown = _assets->get<cugl::graphics::Texture>("Exit_Down");
+        std::shared_ptr<cugl::graphics::Texture> exitUp = TextureAtlas::get(_assets, "Exit_Up");
+        std::shared_ptr<cugl::graphics::Texture> exitDown = TextureAtlas::get(_assets, "Exit_Down");
         
         if (exitUp && exitDown) {
             _exitButton = cugl::scene2::Button::alloc(
@@ -1562,8 +1091,6 @@ void PolarPairsController::showPauseMenu() {
                 _exitButton->setPriority(1001);
             }
             
-            _exitButton->setColor(cugl::Color4(255, 255, 255, 0)); // Start transparent
-            
             // Add button listener using direct callback function
             _exitButton->setName("exit");
             _exitButton->clearListeners();  // Clear any existing listeners
@@ -1574,7 +1101,7 @@ void PolarPairsController::showPauseMenu() {
                 _exitButton->setDown(down);
                 
                 if (down) {  // On press
-                    playButtonPressSound(_assets);
+                    _sounds.play(SoundEvents::Event::BUTTON);
                 } else {  // On release
                     // Deactivate the button immediately
                     _exitButton->deactivate();
@@ -1586,8 +1113,48 @@ void PolarPairsController::showPauseMenu() {
             });
         }
     }
-    _scene->addChild(_exitButton);
-    _exitButton->activate();
+    
+    // The menu fades as one group through its layer, so the nodes keep their own colors
+    if (!_pauseLayer) {
+        _pauseLayer = cugl::scene2::SceneNode::allocWithBounds(size);
+        _pauseLayer->setName("pause");
+        _pauseLayer->setPriority(900);
+    }
+    if (_pauseOverlay && !_pauseOverlay->getParent()) _pauseLayer->addChild(_pauseOverlay);
+    if (_pausedText && !_pausedText->getParent()) _pauseLayer->addChild(_pausedText);
+    if (_resumeButton && !_resumeButton->getParent()) _pauseLayer->addChild(_resumeButton);
+    if (_exitButton && !_exitButton->getParent()) _pauseLayer->addChild(_exitButton);
+}
+
+void PolarPairsController::showPauseMenu() {
+    if (_isPaused) {
+        return; // Already paused
+    }
+    
+    // If instructions are showing, hide them first
+    if (_isShowingInstructions) {
+        hideInstructions();
+    }
+    
+    _isPaused = true;
+    _swipes.reset();
+    
+    // The menu nodes are built once per controller and reused on every pause
+    buildPauseMenu();
+    
+    // Reset the menu to fully transparent and attach it
+    if (_pauseLayer) {
+        _pauseLayer->setColor(cugl::Color4(255, 255, 255, 0));
+        if (!_pauseLayer->getParent()) _renderer.getHUDLayer()->addChild(_pauseLayer);
+    }
+    if (_resumeButton) {
+        _resumeButton->setDown(false);
+        _resumeButton->activate();
+    }
+    if (_exitButton) {
+        _exitButton->setDown(false);
+        _exitButton->activate();
+    }
     
     // Disable gameplay buttons during pause
     if (_restartButton) _restartButton->deactivate();
@@ -1661,47 +1228,26 @@ void PolarPairsController::processPauseMenuInput() {
     }
 }
 
-void PolarPairsController::showInstructions() {
-    if (_isShowingInstructions) {
-        return; // Already showing instructions
-    }
-    
-    // If paused, hide pause menu first
-    if (_isPaused) {
-        hidePauseMenu();
-    }
-    
-    _isShowingInstructions = true;
-    
-    // Clean up any existing elements first (just in case)
-    if (_instructionOverlay && _instructionOverlay->getParent()) {
-        _scene->removeChild(_instructionOverlay);
-        _instructionOverlay = nullptr;
-    }
-    if (_instructionImage && _instructionImage->getParent()) {
-        _scene->removeChild(_instructionImage);
-        _instructionImage = nullptr;
-    }
-    if (_returnButton && _returnButton->getParent()) {
-        _returnButton->deactivate();
-        _scene->removeChild(_returnButton);
-        _returnButton = nullptr;
+void PolarPairsController::buildInstructions() {
+    if (_instructionOverlay && _instructionImage && _returnButton) {
+        return; // Already built
     }
     
     // Create a semi-transparent overlay for instructions
     cugl::Size size = _scene->getSize();
     
-    _instructionOverlay = cugl::scene2::PolygonNode::alloc();
-    _instructionOverlay->setColor(cugl::Color4(0, 0, 0, 0)); // Start fully transparent
-    _instructionOverlay->setContentSize(size);
-    _instructionOverlay->setAnchor(cugl::Vec2::ANCHOR_CENTER);
-    _instructionOverlay->setPosition(size.width/2, size.height/2);
-    _instructionOverlay->setPriority(900); // Below buttons but above game
-    _scene->addChild(_instructionOverlay);
+    if (!_instructionOverlay) {
+        _instructionOverlay = cugl::scene2::PolygonNode::alloc();
+        _instructionOverlay->setColor(cugl::Color4(0, 0, 0, 192));
+        _instructionOverlay->setContentSize(size);
+        _instructionOverlay->setAnchor(cugl::Vec2::ANCHOR_CENTER);
+        _instructionOverlay->setPosition(size.width/2, size.height/2);
+        _instructionOverlay->setPriority(900); // Below buttons but above game
+    }
     
     // Load instruction image
     std::shared_ptr<cugl::graphics::Texture> instructionTexture = _assets->get<cugl::graphics::Texture>("Instruction");
-    if (instructionTexture) {
+    if (instructionTexture && !_instructionImage) {
         _instructionImage = cugl::scene2::PolygonNode::allocWithTexture(instructionTexture);
         
         // Use our helper method to calculate tile size
@@ -1714,17 +1260,13 @@ void PolarPairsController::showInstructions() {
         _instructionImage->setAnchor(cugl::Vec2::ANCHOR_CENTER);
         _instructionImage->setPosition(size.width * INSTRUCTION_IMAGE_X, size.height * INSTRUCTION_IMAGE_Y);
         _instructionImage->setPriority(901);
-        _instructionImage->setColor(cugl::Color4(255, 255, 255, 0)); // Start transparent
-    }
-    if (_instructionImage) {
-        _scene->addChild(_instructionImage);
     }
     
     // Create return button in the same position as the question button
-    std::shared_ptr<cugl::graphics::Texture> returnUp = _assets->get<cugl::graphics::Texture>("Return_Up");
-    std::shared_ptr<cugl::graphics::Texture> returnDown = _assets->get<cugl::graphics::Texture>("Return_Down");
+    std::shared_ptr<cugl::graphics::Texture> returnUp = TextureAtlas::get(_assets, "Return_Up");
+    std::shared_ptr<cugl::graphics::Texture> returnDown = TextureAtlas::get(_assets, "Return_Down");
     
-    if (returnUp && returnDown && _questionButton) {
+    if (returnUp && returnDown && _questionButton && !_returnButton) {
         _returnButton = cugl::scene2::Button::alloc(
             cugl::scene2::PolygonNode::allocWithTexture(returnUp),
             cugl::scene2::PolygonNode::allocWithTexture(returnDown)
@@ -1737,22 +1279,53 @@ void PolarPairsController::showInstructions() {
         _returnButton->setPosition(_questionButton->getPosition());
         _returnButton->setPriority(1001);
         
-        _returnButton->setColor(cugl::Color4(255, 255, 255, 0)); // Start transparent
-        
         // Add button listener with simplified approach
         _returnButton->setName("return");
         _returnButton->clearListeners();  // Clear any existing listeners
         _returnButton->addListener([=] (const std::string& name, bool down) {
             // Handle both press and release events
             if (down) {  // On press
-                playButtonPressSound(_assets);
+                _sounds.play(SoundEvents::Event::BUTTON);
             } else {  // On release
                 hideInstructions();
             }
         });
     }
+    
+    // The instructions fade as one group through their layer
+    if (!_instructionLayer) {
+        _instructionLayer = cugl::scene2::SceneNode::allocWithBounds(size);
+        _instructionLayer->setName("instructions");
+        _instructionLayer->setPriority(900);
+    }
+    if (_instructionOverlay && !_instructionOverlay->getParent()) _instructionLayer->addChild(_instructionOverlay);
+    if (_instructionImage && !_instructionImage->getParent()) _instructionLayer->addChild(_instructionImage);
+    if (_returnButton && !_returnButton->getParent()) _instructionLayer->addChild(_returnButton);
+}
+
+void PolarPairsController::showInstructions() {
+    if (_isShowingInstructions) {
+        return; // Already showing instructions
+    }
+    
+    // If paused, hide pause menu first
+    if (_isPaused) {
+        hidePauseMenu();
+    }
+    
+    _isShowingInstructions = true;
+    _swipes.reset();
+    
+    // The instruction nodes are built once per controller and reused every time
+    buildInstructions();
+    
+    // Reset the instructions to fully transparent and attach them
+    if (_instructionLayer) {
+        _instructionLayer->setColor(cugl::Color4(255, 255, 255, 0));
+        if (!_instructionLayer->getParent()) _renderer.getHUDLayer()->addChild(_instructionLayer);
+    }
     if (_returnButton) {
-        _scene->addChild(_returnButton);
+        _returnButton->setDown(false);
         _returnButton->activate();
     }
     
@@ -1818,44 +1391,16 @@ void PolarPairsController::processInstructionsInput() {
 
 // Add this new method to force cleanup of all UI elements
 void PolarPairsController::forceCleanupAllUIElements() {
-    // Immediately remove all overlay and menu elements
-    if (_pauseOverlay && _pauseOverlay->getParent()) {
-        _scene->removeChild(_pauseOverlay);
-        _pauseOverlay = nullptr;
+    // Immediately detach the menu layers (they are kept for reuse)
+    if (_pauseLayer && _pauseLayer->getParent()) {
+        _pauseLayer->removeFromParent();
     }
-    
-    if (_pausedText && _pausedText->getParent()) {
-        _scene->removeChild(_pausedText);
-        _pausedText = nullptr;
-    }
-    
-    if (_resumeButton && _resumeButton->getParent()) {
-        _resumeButton->deactivate();
-        _scene->removeChild(_resumeButton);
-        _resumeButton = nullptr;
-    }
-    
-    if (_exitButton && _exitButton->getParent()) {
-        _exitButton->deactivate();
-        _scene->removeChild(_exitButton);
-        _exitButton = nullptr;
-    }
-    
-    if (_instructionOverlay && _instructionOverlay->getParent()) {
-        _scene->removeChild(_instructionOverlay);
-        _instructionOverlay = nullptr;
-    }
-    
-    if (_instructionImage && _instructionImage->getParent()) {
-        _scene->removeChild(_instructionImage);
-        _instructionImage = nullptr;
-    }
-    
-    if (_returnButton && _returnButton->getParent()) {
-        _returnButton->deactivate();
-        _scene->removeChild(_returnButton);
-        _returnButton = nullptr;
+    if (_instructionLayer && _instructionLayer->getParent()) {
+        _instructionLayer->removeFromParent();
     }
+    if (_resumeButton) _resumeButton->deactivate();
+    if (_exitButton) _exitButton->deactivate();
+    if (_returnButton) _returnButton->deactivate();
     
     // Reset state flags
     _isPaused = false;
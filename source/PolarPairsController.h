@@ -7,12 +7,14 @@
 #define __GAME_CONTROLLER_H__
 
 #include <cugl/cugl.h>
+#include <deque>
 #include "LevelData.h"
+#include "PuzzleBoard.h"
 #include "PlaygroundRenderer.h"
-
-// Grid dimensions
-#define GRID_WIDTH 7
-#define GRID_HEIGHT 11
+#include "SoundEvents.h"
+#include "InputLatency.h"
+#include "SwipeRecognizer.h"
+#include "LockstepSession.h"
 
 // Button position constants - relative to screen width/height
 #define RESTART_BUTTON_X 0.15f
@@ -29,6 +31,10 @@
 #define INSTRUCTION_IMAGE_SCALE_FACTOR 0.8f
 #define INSTRUCTION_IMAGE_X 0.5f
 #define INSTRUCTION_IMAGE_Y 0.5f
+// Swipes held while a move animates; later swipes are dropped
+#define MAX_QUEUED_MOVES 3
+// Speed-up of the current slide while swipes are queued behind it
+#define FAST_FORWARD_SCALE 3.0f
 
 /**
  * Class for controlling the game logic of PolarPairs.
@@ -39,36 +45,34 @@ private:
     std::shared_ptr<cugl::AssetManager> _assets;
     std::shared_ptr<cugl::scene2::Scene2> _scene;
     PlaygroundRenderer _renderer;
+    SoundEvents _sounds;
+    
+    // Grid, character positions, finish states and move counts
+    PuzzleBoard _board;
     
-    // Grid and level data
-    std::vector<std::vector<int>> _grid;
-    std::vector<cugl::Vec2> _bearBlocks;
-    std::vector<cugl::Vec2> _penguinBlocks;
-    std::vector<cugl::Vec2> _breakableBlocks;
-    std::vector<cugl::Vec2> _bearFinishBlocks;
-    std::vector<cugl::Vec2> _penguinFinishBlocks;
-    
-    // Character positions
-    cugl::Vec2 _polarBearGridPos;
-    cugl::Vec2 _penguinGridPos;
-    
-    // For tracking previous positions
-    cugl::Vec2 _polarBearPrevPos;
-    cugl::Vec2 _penguinPrevPos;
-    
-    // Movement state
-    cugl::Vec2 _polarBearTarget;
-    cugl::Vec2 _penguinTarget;
+    // Movement state; the board changes when the move finishes animating
+    PuzzleBoard::Move _move;
     cugl::Vec2 _moveDirection;
     bool _isMoving;
     float _moveProgress;
     
-    // Move counters and finish states
-    int _bearMoves;
-    int _penguinMoves;
-    bool _bearFinished;
-    bool _penguinFinished;
-    bool _simultaneousDestinationReached;
+    // Swipes made during a move, applied in order as each move resolves
+    std::deque<cugl::Vec2> _queuedMoves;
+    bool _fastForward;
+    
+    /** Swipe latency marks, owned by the app (may be nullptr) */
+    InputLatency* _latency;
+    
+    /** Co-op session, owned by the app (nullptr for single player) */
+    LockstepSession* _coop;
+    
+    // Co-op moves from lockstep frames, applied in frame order like queued swipes
+    struct CoopMove {
+        cugl::Vec2 direction;
+        bool bear;
+        bool penguin;
+    };
+    std::deque<CoopMove> _coopMoves;
     
     // Constant speed movement variables
     float _bearTravelDistance;
@@ -81,7 +85,12 @@ private:
     float _winDelay;        // Delay before showing win screen
     bool _winConditionMet;  // Flag to indicate win condition is met but waiting for animation
     
+    // Play statistics
+    float _levelTime;       // Unpaused seconds since the attempt started
+    bool _attemptOpen;      // True from a start or restart until a win or quit is recorded
+    
     // Touch tracking
+    SwipeRecognizer _swipes;
     bool _touchActive;
     cugl::Vec2 _touchStart;
     cugl::Vec2 _lastTouchPos;
@@ -104,31 +113,6 @@ private:
     };
     std::vector<DelayedBlockRemoval> _blocksToRemove;
     
-    // Squeeze mechanic
-    bool _squeezeJustOccurred;
-    bool _polarBearIsRear;
-    bool checkForSqueeze();
-    
-    // Track which character is being pushed during squeeze (bear = true, penguin = false)
-    bool _bearIsBeingPushed;
-    
-    // Movement and collision
-    cugl::Vec2 calculateSingleCharacterMove(const cugl::Vec2& start, bool isPenguin, const cugl::Vec2& direction);
-    cugl::Vec2 computeTarget(const cugl::Vec2& start, bool isPenguin, bool canBreak,
-                             const cugl::Vec2& direction,
-                             const cugl::Vec2& otherPos,
-                             const cugl::Vec2& otherTarget);
-    cugl::Vec2 slide(const cugl::Vec2& start, bool isPenguin, bool canBreak, const cugl::Vec2& direction);
-    void calculateMovementTargets();
-    void updateCharacterPositions();
-    void updateCharacterPositionsInterpolated(float progress);
-    void updateCharacterPositionsWithSeparateProgress(float bearProgress, float penguinProgress);
-    
-    // Move counters
-    void createMoveCounters();
-    void updateMoveCounters();
-    void updateFinishState();
-    
     // Win condition
     void checkWinCondition();
     
@@ -148,6 +132,9 @@ private:
     /** Flag indicating if the game is paused */
     bool _isPaused;
     
+    /** Parent of the pause menu nodes, faded as one group */
+    std::shared_ptr<cugl::scene2::SceneNode> _pauseLayer;
+    
     /** Semi-transparent overlay for pause menu */
     std::shared_ptr<cugl::scene2::PolygonNode> _pauseOverlay;
     
@@ -164,6 +151,9 @@ private:
     /** Flag indicating if the instruction screen is showing */
     bool _isShowingInstructions;
     
+    /** Parent of the instruction nodes, faded as one group */
+    std::shared_ptr<cugl::scene2::SceneNode> _instructionLayer;
+    
     /** Semi-transparent overlay for instruction menu */
     std::shared_ptr<cugl::scene2::PolygonNode> _instructionOverlay;
     
@@ -193,17 +183,20 @@ private:
     // Menu exit flag
     bool _shouldExitToMenu;
     
-    /** Helper function to check if either character is on their special blocks (passable or finish) */
-    bool checkNoSqueezeBlocks();
-    
     // Movement update
     void updateMovement(float timestep);
     
     // Safe restart that preserves UI elements
     void restartLevel();
     
-    /** Handle character movement with the given direction */
-    void moveCharacters(const cugl::Vec2& direction);
+    /** Handle character movement with the given direction; in co-op only one animal may move */
+    void moveCharacters(const cugl::Vec2& direction, bool moveBear = true, bool movePenguin = true);
+    
+    /** Queue a swipe direction, dropping it if the queue is full */
+    void queueMove(const cugl::Vec2& direction);
+    
+    /** Turns the inputs of one lockstep frame into co-op moves */
+    void queueCoopStep(const LockstepSession::Step& step);
     
     /** Process player input from touch/keyboard */
     void processInput();
@@ -211,12 +204,18 @@ private:
     /** Toggle pause state */
     void togglePause();
     
+    /** Create the pause menu nodes once; later calls reuse them */
+    void buildPauseMenu();
+    
     /** Show pause menu */
     void showPauseMenu();
     
     /** Hide pause menu */
     void hidePauseMenu();
     
+    /** Create the instruction screen nodes once; later calls reuse them */
+    void buildInstructions();
+    
     /** Show instruction screen */
     void showInstructions();
     
@@ -232,60 +231,80 @@ private:
     /** Forces immediate cleanup of all UI elements */
     void forceCleanupAllUIElements();
     
+    /** Creates the restart, pause and question buttons */
+    void buildHUD();
+    
     /** Helper method to calculate tile size based on screen height */
     float calculateTileSize(const cugl::Size& size) const;
     
     /** Timeline for animations and delayed actions */
     std::shared_ptr<cugl::ActionTimeline> _timeline;
     
-    // Finish block animation tracking
-    struct FinishBlockAnimation {
-        int x;
-        int y;
-        bool isBear;
-        float timeRemaining;
-        bool showFlag;
-        
-        FinishBlockAnimation(int posX, int posY, bool bear) 
-            : x(posX), y(posY), isBear(bear), timeRemaining(0.4f), showFlag(false) {}
-    };
-    std::vector<FinishBlockAnimation> _finishAnimations;
-    
 public:
     // Constructors/Destructors
-    PolarPairsController() : _isMoving(false), _moveProgress(0.0f), _hasWon(false),
+    PolarPairsController() : _isMoving(false), _moveProgress(0.0f), _fastForward(true), _latency(nullptr), _coop(nullptr), _hasWon(false),
                            _currentLevel(1), _touchActive(false), _shouldExitToMenu(false),
-                           _bearMoves(0), _penguinMoves(0), _bearFinished(false), _penguinFinished(false),
-                           _simultaneousDestinationReached(false), _bearTravelDistance(0), _penguinTravelDistance(0), _totalTravelDistance(0),
+                           _bearTravelDistance(0), _penguinTravelDistance(0), _totalTravelDistance(0),
                            _touchingPauseButton(false), _restartButtonPressed(false), _pauseButtonPressed(false),
                            _restartButtonOrigColor(cugl::Color4::WHITE), _pauseButtonOrigColor(cugl::Color4::WHITE),
                            _isPaused(false), _exitButton(nullptr), _resumeButton(nullptr), _pauseOverlay(nullptr),
                            _isShowingInstructions(false), _questionButton(nullptr), _returnButton(nullptr), 
                            _instructionOverlay(nullptr), _instructionImage(nullptr),
                            _isFading(false), _fadeTime(0), _fadeDuration(0), _isFadingIn(true),
-                           _winDelay(0.0f), _winConditionMet(false), _bearIsBeingPushed(false) {}
+                           _winDelay(0.0f), _winConditionMet(false), _levelTime(0.0f), _attemptOpen(false) {}
     ~PolarPairsController() { dispose(); }
     
     // Core methods
     void dispose();
-    bool init(const std::shared_ptr<cugl::AssetManager>& assets, const cugl::Size& size);
+    bool init(const std::shared_ptr<cugl::AssetManager>& assets, const cugl::Size& size,
+              const std::shared_ptr<cugl::graphics::SpriteBatch>& batch);
     void update(float timestep);
     
     // Game logic methods
-    void loadLevelData(int levelNum);
+    
+    /** Loads a level, redrawing only the cells that differ from the board shown (eased in if animated) */
+    void loadLevelData(int levelNum, bool animated = false);
+    
+    /** Shows the given level, reusing the scene, HUD and menus; call before the first update */
     void switchLevel(int levelNum);
     
+    /**
+     * Swaps in an edited version of the current level without rebuilding the scene.
+     *
+     * Only the cells that differ are redrawn, and the animals keep their places
+     * where the edit still lets them stand. A slide in progress is dropped.
+     */
+    void reloadLevel(const LevelData& levelData);
+    
+    /** Deactivates every button while the game scene is off screen; switchLevel reactivates them */
+    void deactivate();
+    
     // Accessors
     std::shared_ptr<cugl::scene2::Scene2> getScene() const { return _scene; }
+    std::shared_ptr<cugl::scene2::SceneNode> getBackgroundLayer() const { return _renderer.getBackgroundLayer(); }
+    
+    /** Returns the parent of the board and HUD layers, faded as one group */
+    std::shared_ptr<cugl::scene2::SceneNode> getForegroundLayer() const { return _renderer.getForegroundLayer(); }
+    bool isAnimating() const;
+    bool isMoving() const { return _isMoving; }
+    
+    /** Sets whether queued swipes speed up the slide in progress (on by default) */
+    void setFastForward(bool value) { _fastForward = value; }
+    
+    /** Sets where swipes are timed from touch to screen (nullptr to stop) */
+    void setInputLatency(InputLatency* latency) { _latency = latency; }
+    
+    /**
+     * Plays co-op through session (nullptr for single player).
+     *
+     * Local swipes drive only this player's animal, and restart is disabled
+     * since it would put the two boards out of step.
+     */
+    void setCoop(LockstepSession* session);
     bool hasWon() const { return _hasWon; }
     int getCurrentLevel() const { return _currentLevel; }
     bool shouldExitToMenu() const { return _shouldExitToMenu; }
     void resetExitFlag() { _shouldExitToMenu = false; }
-    
-    /**
-     * Updates finish block animations
-     */
-    void updateFinishBlockAnimations(float timestep);
 };
 
 #endif /* __GAME_CONTROLLER_H__ */
\ No newline at end of file
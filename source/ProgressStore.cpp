@@ -0,0 +1,196 @@
+//
+//  ProgressStore.cpp
+//  PolarPairs
+//
+
+#include "ProgressStore.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+/** File signature */
+static const char MAGIC[4] = { 'P', 'P', 'R', 'G' };
+
+/** Bytes used by the packed stars and unlocked arrays of a set */
+static size_t starBytes(uint32_t count) { return (count + 3) / 4; }
+static size_t unlockBytes(uint32_t count) { return (count + 7) / 8; }
+
+ProgressStore::LevelSet* ProgressStore::find(uint16_t set) {
+    for (auto& entry : _sets) {
+        if (entry.id == set) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const ProgressStore::LevelSet* ProgressStore::find(uint16_t set) const {
+    for (const auto& entry : _sets) {
+        if (entry.id == set) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void ProgressStore::resize(uint16_t set, uint32_t count) {
+    LevelSet* entry = find(set);
+    if (!entry) {
+        _sets.push_back({ set, 0, {}, {} });
+        entry = &_sets.back();
+    }
+
+    // Clear the bits past the new end so a later grow starts them at zero
+    for (uint32_t level = count + 1; level <= entry->count && level <= count + 8; level++) {
+        uint32_t i = level - 1;
+        entry->stars[i / 4] &= ~(3 << ((i % 4) * 2));
+        entry->unlocked[i / 8] &= ~(1 << (i % 8));
+    }
+    entry->count = count;
+    entry->stars.resize(starBytes(count), 0);
+    entry->unlocked.resize(unlockBytes(count), 0);
+}
+
+uint32_t ProgressStore::getCount(uint16_t set) const {
+    const LevelSet* entry = find(set);
+    return entry ? entry->count : 0;
+}
+
+int ProgressStore::getStars(uint16_t set, uint32_t level) const {
+    const LevelSet* entry = find(set);
+    if (!entry || level == 0 || level > entry->count) {
+        return 0;
+    }
+    uint32_t i = level - 1;
+    return (entry->stars[i / 4] >> ((i % 4) * 2)) & 3;
+}
+
+void ProgressStore::setStars(uint16_t set, uint32_t level, int stars) {
+    LevelSet* entry = find(set);
+    if (!entry || level == 0 || level > entry->count) {
+        return;
+    }
+    uint32_t i = level - 1;
+    int shift = (i % 4) * 2;
+    uint8_t value = (uint8_t)std::max(0, std::min(3, stars));
+    entry->stars[i / 4] = (entry->stars[i / 4] & ~(3 << shift)) | (value << shift);
+}
+
+bool ProgressStore::isUnlocked(uint16_t set, uint32_t level) const {
+    const LevelSet* entry = find(set);
+    if (!entry || level == 0 || level > entry->count) {
+        return false;
+    }
+    uint32_t i = level - 1;
+    return (entry->unlocked[i / 8] >> (i % 8)) & 1;
+}
+
+void ProgressStore::setUnlocked(uint16_t set, uint32_t level, bool unlocked) {
+    LevelSet* entry = find(set);
+    if (!entry || level == 0 || level > entry->count) {
+        return;
+    }
+    uint32_t i = level - 1;
+    if (unlocked) {
+        entry->unlocked[i / 8] |= (1 << (i % 8));
+    } else {
+        entry->unlocked[i / 8] &= ~(1 << (i % 8));
+    }
+}
+
+std::string ProgressStore::serialize() const {
+    std::string data(MAGIC, sizeof(MAGIC));
+    auto put = [&](uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            data.push_back((char)((value >> (8 * i)) & 0xff));
+        }
+    };
+
+    put(VERSION, 2);
+    put((uint32_t)_sets.size(), 2);
+    for (const auto& entry : _sets) {
+        put(entry.id, 2);
+        put(entry.count, 4);
+        data.append((const char*)entry.stars.data(), entry.stars.size());
+        data.append((const char*)entry.unlocked.data(), entry.unlocked.size());
+    }
+    put(crc32((const uint8_t*)data.data(), data.size()), 4);
+    return data;
+}
+
+bool ProgressStore::deserialize(const std::string& data) {
+    const uint8_t* bytes = (const uint8_t*)data.data();
+    size_t size = data.size();
+    if (size < sizeof(MAGIC) + 8 || std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+
+    size_t pos = sizeof(MAGIC);
+    auto get = [&](int count) {
+        uint32_t value = 0;
+        for (int i = 0; i < count; i++) {
+            value |= (uint32_t)bytes[pos++] << (8 * i);
+        }
+        return value;
+    };
+
+    // The checksum covers everything before it
+    size_t body = size - 4;
+    pos = body;
+    if (get(4) != crc32(bytes, body)) {
+        return false;
+    }
+
+    pos = sizeof(MAGIC);
+    if (get(2) != VERSION) {
+        return false;
+    }
+    uint32_t setCount = get(2);
+
+    std::vector<LevelSet> sets;
+    sets.reserve(setCount);
+    for (uint32_t s = 0; s < setCount; s++) {
+        if (pos + 6 > body) {
+            return false;
+        }
+        LevelSet entry;
+        entry.id = (uint16_t)get(2);
+        entry.count = get(4);
+        size_t stars = starBytes(entry.count);
+        size_t unlocked = unlockBytes(entry.count);
+        if (pos + stars + unlocked > body) {
+            return false;
+        }
+        entry.stars.assign(bytes + pos, bytes + pos + stars);
+        pos += stars;
+        entry.unlocked.assign(bytes + pos, bytes + pos + unlocked);
+        pos += unlocked;
+        sets.push_back(std::move(entry));
+    }
+    if (pos != body) {
+        return false;
+    }
+
+    _sets.swap(sets);
+    return true;
+}
+
+uint32_t ProgressStore::crc32(const uint8_t* data, size_t size) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries;
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+        return entries;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
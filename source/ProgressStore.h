@@ -0,0 +1,88 @@
+//
+//  ProgressStore.h
+//  PolarPairs
+//
+
+#ifndef __PROGRESS_STORE_H__
+#define __PROGRESS_STORE_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Level progress for any number of level sets, packed for a small save file.
+ *
+ * Each set keeps 2 bits of stars per level and 1 bit of unlocked state, so
+ * ten thousand levels take under 4 KB. The packed arrays are the file
+ * format, and loading is a header check, a checksum and a copy.
+ *
+ * File layout (little-endian):
+ *   magic "PPRG", u16 version, u16 set count
+ *   per set: u16 set id, u32 level count,
+ *            stars (4 levels per byte), unlocked (8 levels per byte)
+ *   u32 CRC-32 of everything before it
+ *
+ * Levels are numbered from 1 within their set.
+ */
+class ProgressStore {
+public:
+    /** Current file format version */
+    static constexpr uint16_t VERSION = 1;
+
+private:
+    struct LevelSet {
+        uint16_t id;
+        uint32_t count;
+        std::vector<uint8_t> stars;
+        std::vector<uint8_t> unlocked;
+    };
+    std::vector<LevelSet> _sets;
+
+    /** Returns the set with the given id, or nullptr */
+    LevelSet* find(uint16_t set);
+    const LevelSet* find(uint16_t set) const;
+
+public:
+    /** Removes every set */
+    void clear() { _sets.clear(); }
+
+    /**
+     * Sets the number of levels in a set, adding the set if needed.
+     *
+     * Progress for levels that remain is kept; new levels start locked with
+     * no stars.
+     */
+    void resize(uint16_t set, uint32_t count);
+
+    /** Returns the number of levels in the set (0 if it does not exist) */
+    uint32_t getCount(uint16_t set) const;
+
+    /** Returns the stars (0-3) of a level, 0 if it does not exist */
+    int getStars(uint16_t set, uint32_t level) const;
+
+    /** Sets the stars (clamped to 0-3) of an existing level */
+    void setStars(uint16_t set, uint32_t level, int stars);
+
+    /** Returns true if the level exists and is unlocked */
+    bool isUnlocked(uint16_t set, uint32_t level) const;
+
+    /** Sets the unlocked state of an existing level */
+    void setUnlocked(uint16_t set, uint32_t level, bool unlocked);
+
+    /** Returns the file contents for the current progress */
+    std::string serialize() const;
+
+    /**
+     * Replaces the progress with the file contents.
+     *
+     * Returns false, leaving the progress unchanged, if the data is not a
+     * progress file of a known version or fails its checksum.
+     */
+    bool deserialize(const std::string& data);
+
+    /** Returns the CRC-32 of the bytes */
+    static uint32_t crc32(const uint8_t* data, size_t size);
+};
+
+#endif /* __PROGRESS_STORE_H__ */
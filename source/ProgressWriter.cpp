@@ -0,0 +1,165 @@
+//
+//  ProgressWriter.cpp
+//  PolarPairs
+//
+
+#include "ProgressWriter.h"
+#include <algorithm>
+#include <cstdio>
+#if defined(__WINDOWS__)
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+bool ProgressWriter::start(const std::string& path) {
+    if (_worker.joinable()) {
+        return false;
+    }
+    _path = path;
+    _stopping = false;
+    _worker = std::thread([this] { run(); });
+    return true;
+}
+
+void ProgressWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_worker.joinable()) {
+            return;
+        }
+        _stopping = true;
+    }
+    _wake.notify_all();
+    _worker.join();
+    CULog("%s", getReport().c_str());
+}
+
+void ProgressWriter::write(const std::string& contents) {
+    if (!_worker.joinable()) {
+        // Not started; write in place rather than lose the change
+        commit(contents);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_hasPending) {
+        _pendingSince = std::chrono::steady_clock::now();
+    }
+    _pending = contents;
+    _hasPending = true;
+    _submitted++;
+    _wake.notify_one();
+}
+
+void ProgressWriter::flush() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_worker.joinable()) {
+        _done.wait(lock, [this] { return !_hasPending && !_writing; });
+    }
+}
+
+void ProgressWriter::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _wake.wait(lock, [this] { return _hasPending || _stopping; });
+        if (!_hasPending) {
+            break;  // Stopping with nothing left to write
+        }
+        
+        // Give back-to-back changes a moment to land in the same snapshot
+        if (!_stopping) {
+            _wake.wait_for(lock, std::chrono::milliseconds(COALESCE_MS), [this] { return _stopping; });
+        }
+        
+        std::string contents;
+        contents.swap(_pending);
+        auto since = _pendingSince;
+        int taken = _submitted;
+        int changes = taken - _committed - _failed;
+        _hasPending = false;
+        _writing = true;
+        lock.unlock();
+        
+        bool ok = commit(contents);
+        auto elapsed = std::chrono::steady_clock::now() - since;
+        float millis = std::chrono::duration<float, std::milli>(elapsed).count();
+        
+        lock.lock();
+        _writing = false;
+        if (ok) {
+            // Every change handed over before the snapshot was taken is in it
+            _committed = taken - _failed;
+            _latencies.push_back(millis);
+            CULog("Saved progress in %.1f ms (%d change%s)", millis, changes, changes == 1 ? "" : "s");
+        } else {
+            _failed = taken - _committed;
+        }
+        _done.notify_all();
+    }
+}
+
+bool ProgressWriter::commit(const std::string& contents) {
+    return replaceFile(_path, contents);
+}
+
+bool ProgressWriter::replaceFile(const std::string& path, const std::string& contents) {
+    std::string temp = path + ".tmp";
+    FILE* file = std::fopen(temp.c_str(), "wb");
+    if (!file) {
+        CULog("Could not open save file for writing at: %s", temp.c_str());
+        return false;
+    }
+    
+    bool ok = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    ok = std::fflush(file) == 0 && ok;
+#if defined(__WINDOWS__)
+    ok = _commit(_fileno(file)) == 0 && ok;
+#else
+    ok = fsync(fileno(file)) == 0 && ok;
+#endif
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        CULog("Could not write save file: %s", temp.c_str());
+        std::remove(temp.c_str());
+        return false;
+    }
+    
+    // Swap the new file in; readers see either the old or the new file
+#if defined(__WINDOWS__)
+    ok = MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    ok = std::rename(temp.c_str(), path.c_str()) == 0;
+    if (ok) {
+        // Sync the directory so the rename itself survives a crash
+        size_t slash = path.find_last_of('/');
+        std::string dir = slash == std::string::npos ? "." : path.substr(0, slash);
+        int fd = open(dir.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            close(fd);
+        }
+    }
+#endif
+    if (!ok) {
+        CULog("Could not replace save file: %s", path.c_str());
+        std::remove(temp.c_str());
+    }
+    return ok;
+}
+
+std::string ProgressWriter::getReport() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<float> sorted = _latencies;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](float p) {
+        return sorted.empty() ? 0.0f : sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+    };
+    
+    char text[160];
+    snprintf(text, sizeof(text), "Progress saves: %d changes, %d commits, %d failed, latency p50 %.1f p90 %.1f max %.1f ms",
+             _submitted, _committed, _failed, percentile(0.5f), percentile(0.9f), sorted.empty() ? 0.0f : sorted.back());
+    return text;
+}
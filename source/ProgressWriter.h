@@ -0,0 +1,94 @@
+//
+//  ProgressWriter.h
+//  PolarPairs
+//
+
+#ifndef __PROGRESS_WRITER_H__
+#define __PROGRESS_WRITER_H__
+
+#include <cugl/cugl.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Writes a save file behind the game on a worker thread.
+ *
+ * The owner keeps its data in memory and hands over a complete snapshot of
+ * the file after each change. Snapshots that arrive while one is waiting
+ * replace it, so a burst of changes (a win sets the score and unlocks the
+ * next level) becomes one write. The worker writes to a temporary file,
+ * syncs it to disk and renames it over the save file, so a crash in the
+ * middle of a write leaves the previous file intact.
+ *
+ * The time from handing over a snapshot to the rename is recorded, and a
+ * summary of those commit latencies is logged when the writer stops.
+ */
+class ProgressWriter {
+public:
+    /** Milliseconds the worker waits for more changes before writing */
+    static constexpr int COALESCE_MS = 50;
+
+private:
+    std::string _path;
+    std::thread _worker;
+    mutable std::mutex _mutex;
+    std::condition_variable _wake;
+    /** Signalled when a commit finishes, for flush() */
+    std::condition_variable _done;
+
+    /** The snapshot waiting to be written */
+    std::string _pending;
+    bool _hasPending;
+    /** True while the worker is writing a snapshot it took */
+    bool _writing;
+    bool _stopping;
+    /** When the oldest change in the pending snapshot was handed over */
+    std::chrono::steady_clock::time_point _pendingSince;
+
+    /** Changes handed over, and how many of them reached disk or failed */
+    int _submitted;
+    int _committed;
+    int _failed;
+    /** Commit latencies in milliseconds */
+    std::vector<float> _latencies;
+
+    /** Waits for snapshots and commits them until stopped */
+    void run();
+
+    /** Writes, syncs and renames one snapshot; returns false on failure */
+    bool commit(const std::string& contents);
+
+public:
+    ProgressWriter() : _hasPending(false), _writing(false), _stopping(false),
+                       _submitted(0), _committed(0), _failed(0) {}
+    ~ProgressWriter() { stop(); }
+
+    /** Starts the worker for the given save file */
+    bool start(const std::string& path);
+
+    /** Writes any pending snapshot, stops the worker and logs the latencies */
+    void stop();
+
+    /** Hands over the full contents of the save file; returns immediately */
+    void write(const std::string& contents);
+
+    /** Blocks until every snapshot handed over so far is on disk */
+    void flush();
+
+    /** Returns the commit count and latency percentiles as one line */
+    std::string getReport() const;
+    
+    /**
+     * Writes a file through a synced temporary file and a rename.
+     *
+     * This is the commit the worker uses, for callers that manage their own
+     * thread. Returns false, leaving any old file intact, on failure.
+     */
+    static bool replaceFile(const std::string& path, const std::string& contents);
+};
+
+#endif /* __PROGRESS_WRITER_H__ */
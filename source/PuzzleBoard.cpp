@@ -0,0 +1,430 @@
+//
+//  PuzzleBoard.cpp
+//  PolarPairs
+//
+
+#include "PuzzleBoard.h"
+#include <algorithm>
+
+// Special constant for "no target"
+static const cugl::Vec2 NO_TARGET(-999, -999);
+
+/** Adds a block to break, once */
+static void addBreak(std::vector<cugl::Vec2>& breaks, const cugl::Vec2& pos) {
+    if (std::find(breaks.begin(), breaks.end(), pos) == breaks.end()) {
+        breaks.push_back(pos);
+    }
+}
+
+PuzzleBoard::PuzzleBoard() :
+    _bearFinished(false), _penguinFinished(false), _bearMoves(0), _penguinMoves(0),
+    _together(false), _bearPar(0), _penguinPar(0) {
+    _grid.assign(GRID_WIDTH, std::vector<int>(GRID_HEIGHT, 0));
+}
+
+void PuzzleBoard::load(const LevelData& data) {
+    _bearPos = data.polarBearPos;
+    _penguinPos = data.penguinPos;
+    _bearFinishBlocks = data.bearFinishBlocks;
+    _penguinFinishBlocks = data.penguinFinishBlocks;
+    _bearFinished = false;
+    _penguinFinished = false;
+    _bearMoves = 0;
+    _penguinMoves = 0;
+    _together = false;
+    _bearPar = data.bearTargetMoves;
+    _penguinPar = data.penguinTargetMoves;
+
+    // Reset grid
+    for (auto& column : _grid) std::fill(column.begin(), column.end(), 0);
+
+    // Update grid with block positions - all in one loop
+    auto updateGrid = [&](const std::vector<cugl::Vec2>& blocks, int type) {
+        for (const auto& pos : blocks) {
+            if (pos.x >= 0 && pos.x < GRID_WIDTH && pos.y >= 0 && pos.y < GRID_HEIGHT) {
+                _grid[pos.x][pos.y] = type;
+            }
+        }
+    };
+
+    // Set all blocks in grid with their types
+    updateGrid(data.blocks, 1);  // Regular obstacles (X)
+    updateGrid(data.invisibleBlocks, 7);
+    updateGrid(data.bearBlocks, 2);
+    updateGrid(data.penguinBlocks, 3);
+    updateGrid(data.bearFinishBlocks, 4);
+    updateGrid(data.penguinFinishBlocks, 5);
+    updateGrid(data.breakableBlocks, 6);
+}
+
+void PuzzleBoard::reload(const LevelData& data) {
+    std::vector<std::vector<int>> grid = _grid;
+    cugl::Vec2 bearPos = _bearPos;
+    cugl::Vec2 penguinPos = _penguinPos;
+    int bearMoves = _bearMoves;
+    int penguinMoves = _penguinMoves;
+    bool together = _together;
+    load(data);
+
+    for (int x = 0; x < GRID_WIDTH; x++) {
+        for (int y = 0; y < GRID_HEIGHT; y++) {
+            if (grid[x][y] == 8 && _grid[x][y] == 6) {
+                _grid[x][y] = 8;
+            }
+        }
+    }
+
+    // An animal that now stands in a wall, on the other's tiles or on the
+    // other animal starts over; the other one keeps its place
+    bool keepBear = canStand(bearPos, false);
+    bool keepPenguin = canStand(penguinPos, true);
+    if (keepBear && keepPenguin && bearPos == penguinPos) {
+        keepPenguin = false;
+    }
+    if (keepBear) _bearPos = bearPos;
+    if (keepPenguin) _penguinPos = penguinPos;
+    if (_bearPos == _penguinPos) {
+        // The kept animal is on the other's start
+        if (keepBear) _bearPos = data.polarBearPos;
+        else _penguinPos = data.penguinPos;
+    }
+
+    _bearMoves = bearMoves;
+    _penguinMoves = penguinMoves;
+    _together = together;
+    _bearFinished = isFinish(_bearPos, false);
+    _penguinFinished = isFinish(_penguinPos, true);
+}
+
+PuzzleBoard::Move PuzzleBoard::plan(const cugl::Vec2& direction, bool moveBear, bool movePenguin) const {
+    Move move;
+    move.direction = direction;
+    move.squeeze = false;
+    move.bearPushed = false;
+
+    // Initialize targets to current positions
+    move.bearTarget = _bearPos;
+    move.penguinTarget = _penguinPos;
+
+    // If both characters are on their finish blocks (or held), don't calculate new targets
+    bool bearHeld = _bearFinished || !moveBear;
+    bool penguinHeld = _penguinFinished || !movePenguin;
+    if (bearHeld && penguinHeld) {
+        return move;
+    }
+
+    // Check for squeeze first - handles a special movement case
+    bool bearRear = false;
+    move.squeeze = checkForSqueeze(direction, bearRear, move.breaks);
+
+    if (move.squeeze) {
+        // Squeeze mechanics: rear character pushes front character in opposite direction
+        bool bearFront = !bearRear;
+
+        // The bear is the one moving in the opposite direction if it's the front character
+        move.bearPushed = bearFront;
+
+        // Calculate movements for front and rear characters
+        cugl::Vec2 frontStart = bearFront ? _bearPos : _penguinPos;
+        cugl::Vec2 rearStart = bearFront ? _penguinPos : _bearPos;
+        bool frontIsPenguin = !bearFront;
+
+        // Calculate slide targets
+        cugl::Vec2 frontTarget = slide(frontStart, frontIsPenguin, true, -direction, move.breaks);
+        cugl::Vec2 rearTarget = slide(rearStart, !frontIsPenguin, true, direction, move.breaks);
+
+        // Assign targets based on finish state
+        if (bearFront) {
+            if (!bearHeld) move.bearTarget = frontTarget;
+            if (!penguinHeld) move.penguinTarget = rearTarget;
+        } else {
+            if (!penguinHeld) move.penguinTarget = frontTarget;
+            if (!bearHeld) move.bearTarget = rearTarget;
+        }
+    } else {
+        // Standard movement: determine which character is in front
+        bool bearInFront = false;
+        if (direction.x != 0) {
+            bearInFront = (direction.x > 0) ?
+                          (_bearPos.x > _penguinPos.x) :
+                          (_bearPos.x < _penguinPos.x);
+        } else {
+            bearInFront = (direction.y > 0) ?
+                          (_bearPos.y > _penguinPos.y) :
+                          (_bearPos.y < _penguinPos.y);
+        }
+
+        // Calculate targets for front and rear characters
+        cugl::Vec2 frontPos = bearInFront ? _bearPos : _penguinPos;
+        cugl::Vec2 rearPos = bearInFront ? _penguinPos : _bearPos;
+        bool frontIsPenguin = !bearInFront;
+
+        // Calculate front character target first
+        cugl::Vec2 frontTarget = frontPos;
+        if (!(bearHeld && bearInFront) && !(penguinHeld && !bearInFront)) {
+            frontTarget = computeTarget(frontPos, frontIsPenguin, false, direction, rearPos, NO_TARGET, move.breaks);
+            if (bearInFront) move.bearTarget = frontTarget;
+            else move.penguinTarget = frontTarget;
+        }
+
+        // Now calculate rear character target using the UPDATED front target position
+        if (!(bearHeld && !bearInFront) && !(penguinHeld && bearInFront)) {
+            cugl::Vec2 rearTarget = computeTarget(rearPos, !frontIsPenguin, false, direction,
+                                                  frontTarget, frontTarget, move.breaks);
+            if (bearInFront) move.penguinTarget = rearTarget;
+            else move.bearTarget = rearTarget;
+        }
+
+        // Prevent character overlap
+        if (move.bearTarget == move.penguinTarget) {
+            if (bearInFront) move.penguinTarget = move.bearTarget - direction;
+            else move.bearTarget = move.penguinTarget - direction;
+        }
+    }
+    return move;
+}
+
+PuzzleBoard::Result PuzzleBoard::apply(const Move& move) {
+    Result result;
+    cugl::Vec2 bearStart = _bearPos;
+    cugl::Vec2 penguinStart = _penguinPos;
+    _bearPos = move.bearTarget;
+    _penguinPos = move.penguinTarget;
+
+    // Check if characters actually moved
+    result.bearMoved = _bearPos != bearStart;
+    result.penguinMoved = _penguinPos != penguinStart;
+
+    // Both characters moved a significant distance in the same move
+    result.together = false;
+    if (result.bearMoved && result.penguinMoved) {
+        float bearDistance = (_bearPos - bearStart).length();
+        float penguinDistance = (_penguinPos - penguinStart).length();
+        if (bearDistance > 0.01f && penguinDistance > 0.01f) {
+            result.together = true;
+            _together = true;
+        }
+    }
+
+    // Increment move counters if characters actually moved
+    if (result.bearMoved) _bearMoves++;
+    if (result.penguinMoved) _penguinMoves++;
+
+    // Cracked blocks become passable (type 8) for the next move
+    for (const auto& pos : move.breaks) {
+        if (pos.x >= 0 && pos.x < GRID_WIDTH && pos.y >= 0 && pos.y < GRID_HEIGHT && _grid[pos.x][pos.y] == 6) {
+            _grid[pos.x][pos.y] = 8;
+        }
+    }
+
+    // Check finish states
+    bool wasBearFinished = _bearFinished;
+    bool wasPenguinFinished = _penguinFinished;
+    _bearFinished = isFinish(_bearPos, false);
+    _penguinFinished = isFinish(_penguinPos, true);
+    result.bearArrived = _bearFinished && !wasBearFinished;
+    result.penguinArrived = _penguinFinished && !wasPenguinFinished;
+    return result;
+}
+
+int PuzzleBoard::getScore() const {
+    int score = 0;
+
+    // Score +1 if bear takes less steps than target
+    if (_bearMoves <= _bearPar) {
+        score += 1;
+    }
+
+    // Score +1 if seal takes less steps than target
+    if (_penguinMoves <= _penguinPar) {
+        score += 1;
+    }
+
+    // Add third point if both characters reached destination at the same time
+    if (_together) {
+        score += 1;
+    }
+    return score;
+}
+
+bool PuzzleBoard::isFinish(const cugl::Vec2& pos, bool isPenguin) const {
+    for (const auto& finish : isPenguin ? _penguinFinishBlocks : _bearFinishBlocks) {
+        if (pos.x == finish.x && pos.y == finish.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PuzzleBoard::canStand(const cugl::Vec2& pos, bool isPenguin) const {
+    if (pos.x < 0 || pos.x >= GRID_WIDTH || pos.y < 0 || pos.y >= GRID_HEIGHT) return false;
+    int cell = _grid[pos.x][pos.y];
+    if (cell == 1 || cell == 6 || cell == 7) return false;
+    return isPenguin ? (cell != 2 && cell != 4) : (cell != 3 && cell != 5);
+}
+
+// --- Squeeze logic ---
+bool PuzzleBoard::checkForSqueeze(const cugl::Vec2& direction, bool& bearRear, std::vector<cugl::Vec2>& breaks) const {
+    cugl::Vec2 diff = _bearPos - _penguinPos;
+
+    // Quick check: must be adjacent and aligned with movement direction
+    if (diff.length() != 1.0f) return false;
+
+    // Check alignment with movement in one step
+    bool isHorizontal = direction.x != 0;
+    if ((isHorizontal && diff.y != 0) || (!isHorizontal && diff.x != 0)) return false;
+
+    // Determine which character is in front (simplified logic)
+    bool bearInFront = (isHorizontal ?
+                       (direction.x * diff.x > 0) :
+                       (direction.y * diff.y > 0));
+
+    // Get front character position and next position in one step
+    cugl::Vec2 frontPos = bearInFront ? _bearPos : _penguinPos;
+    cugl::Vec2 frontNext = frontPos + direction;
+
+    // Check boundary first (fastest check)
+    if (frontNext.x < 0 || frontNext.x >= GRID_WIDTH ||
+        frontNext.y < 0 || frontNext.y >= GRID_HEIGHT) {
+        // Only check special blocks if we would squeeze
+        if (checkNoSqueezeBlocks()) return false;
+        bearRear = !bearInFront;
+        return true;
+    }
+
+    // Check cell type
+    int cell = _grid[frontNext.x][frontNext.y];
+    bool blocked = (cell == 1 || cell == 7) || // Regular or invisible block
+                  (bearInFront && (cell == 3 || cell == 5)) || // Bear blocked by penguin tiles
+                  (!bearInFront && (cell == 2 || cell == 4)); // Penguin blocked by bear tiles
+
+    if (cell == 6) { // Breakable block
+        addBreak(breaks, frontNext);
+        blocked = true;
+    }
+
+    if (blocked) {
+        // Only check special blocks if we would squeeze
+        if (checkNoSqueezeBlocks()) return false;
+        bearRear = !bearInFront;
+        return true;
+    }
+
+    return false;
+}
+
+// Helper function to check if either character is on their special blocks (passable or finish)
+bool PuzzleBoard::checkNoSqueezeBlocks() const {
+    int bearCell = _grid[_bearPos.x][_bearPos.y];
+    int penguinCell = _grid[_penguinPos.x][_penguinPos.y];
+    // Check both passable blocks (2,3) and finish blocks (4,5)
+    return (bearCell == 2 || bearCell == 4 || penguinCell == 3 || penguinCell == 5);
+}
+
+cugl::Vec2 PuzzleBoard::slide(const cugl::Vec2& start, bool isPenguin, bool canBreak, const cugl::Vec2& direction,
+                              std::vector<cugl::Vec2>& breaks) const {
+    cugl::Vec2 curr = start;
+
+    while (true) {
+        cugl::Vec2 next = curr + direction;
+
+        // Check boundary
+        if (next.x < 0 || next.x >= GRID_WIDTH || next.y < 0 || next.y >= GRID_HEIGHT) break;
+
+        // Check cell type
+        int cell = _grid[next.x][next.y];
+        if (cell == 1 || cell == 7) break; // Regular or invisible block
+
+        // Block characters from entering wrong finish blocks or other character's blocks
+        if (isPenguin) {
+            if (cell == 2 || cell == 4) break; // Block penguin from bear blocks and bear finish
+        } else {
+            if (cell == 3 || cell == 5) break; // Block bear from penguin blocks and penguin finish
+        }
+
+        // If moving to a finish block, move there and stop
+        if (isFinish(next, isPenguin)) {
+            curr = next;
+            break;
+        }
+
+        if (cell == 6) { // Breakable block
+            if (canBreak) {
+                // Break the block and continue moving through it
+                addBreak(breaks, next);
+                curr = next;
+            } else {
+                curr = next; // allow moving into breakable block for check
+                break;
+            }
+        } else {
+            // Move to next position for non-breakable blocks
+            curr = next;
+        }
+    }
+
+    return curr;
+}
+
+cugl::Vec2 PuzzleBoard::computeTarget(const cugl::Vec2& start, bool isPenguin, bool canBreak,
+                                      const cugl::Vec2& direction,
+                                      const cugl::Vec2& otherStart,
+                                      const cugl::Vec2& otherTarget,
+                                      std::vector<cugl::Vec2>& breaks) const {
+    cugl::Vec2 curr = start;
+
+    while (true) {
+        cugl::Vec2 next = curr + direction;
+
+        // Check boundary
+        if (next.x < 0 || next.x >= GRID_WIDTH || next.y < 0 || next.y >= GRID_HEIGHT) break;
+
+        // Check for other character's current or future position
+        if (next == otherTarget || (otherTarget == NO_TARGET && next == otherStart)) break;
+
+        // Check if characters are aligned on movement axis and would pass through each other
+        bool wouldPassThroughOther = false;
+        if (direction.x != 0) { // Horizontal movement
+            if (next.y == otherStart.y) { // Same row
+                // Check if we'd pass through the other character
+                if ((direction.x > 0 && curr.x < otherStart.x && next.x > otherStart.x) ||
+                    (direction.x < 0 && curr.x > otherStart.x && next.x < otherStart.x)) {
+                    wouldPassThroughOther = true;
+                }
+            }
+        } else if (direction.y != 0) { // Vertical movement
+            if (next.x == otherStart.x) { // Same column
+                // Check if we'd pass through the other character
+                if ((direction.y > 0 && curr.y < otherStart.y && next.y > otherStart.y) ||
+                    (direction.y < 0 && curr.y > otherStart.y && next.y < otherStart.y)) {
+                    wouldPassThroughOther = true;
+                }
+            }
+        }
+
+        if (wouldPassThroughOther) break;
+
+        // Check cell type
+        int cell = _grid[next.x][next.y];
+        if (cell == 1 || cell == 7) break; // Regular or invisible block
+        if (isPenguin && (cell == 2 || cell == 4)) break; // Bear block or finish
+        if (!isPenguin && (cell == 3 || cell == 5)) break; // Penguin block or finish
+
+        // If moving to a finish block, move there and stop
+        if (isFinish(next, isPenguin)) {
+            curr = next;
+            break;
+        }
+
+        if (cell == 6) { // Breakable block
+            if (canBreak) {
+                addBreak(breaks, next);
+            } else break;
+        }
+
+        // Move to next position
+        curr = next;
+    }
+
+    return curr;
+}
@@ -0,0 +1,129 @@
+//
+//  PuzzleBoard.h
+//  PolarPairs
+//
+
+#ifndef __PUZZLE_BOARD_H__
+#define __PUZZLE_BOARD_H__
+
+#include <cugl/core/cu_core.h>
+#include <vector>
+#include "LevelData.h"
+
+// Grid dimensions
+#define GRID_WIDTH 7
+#define GRID_HEIGHT 11
+
+/**
+ * The rules of a PolarPairs board: the grid, where the bear and penguin
+ * stand, and where a swipe sends them.
+ *
+ * Grid cells are 0 empty, 1 block, 2 bear-only, 3 penguin-only, 4 bear
+ * finish, 5 penguin finish, 6 breakable, 7 invisible block and 8 broken.
+ *
+ * Nothing here draws, plays sounds or keeps time, so this builds into the
+ * headless library that tools and tests link as well as into the game. A
+ * swipe is planned first and applied once the controller has animated it.
+ */
+class PuzzleBoard {
+public:
+    /** Where one swipe sends the two animals */
+    struct Move {
+        cugl::Vec2 direction;
+        cugl::Vec2 bearTarget;
+        cugl::Vec2 penguinTarget;
+        /** Whether the rear animal pushed the front one back the other way */
+        bool squeeze;
+        /** Whether the bear is the one pushed back by the squeeze */
+        bool bearPushed;
+        /** Breakable blocks the move cracks; they break when it is applied */
+        std::vector<cugl::Vec2> breaks;
+    };
+
+    /** What applying a move changed, for the sounds and animations */
+    struct Result {
+        bool bearMoved;
+        bool penguinMoved;
+        /** Whether each animal has just reached its finish */
+        bool bearArrived;
+        bool penguinArrived;
+        /** Whether both animals slid the whole move together */
+        bool together;
+    };
+
+private:
+    /** Cell types, indexed [x][y] with y up */
+    std::vector<std::vector<int>> _grid;
+    std::vector<cugl::Vec2> _bearFinishBlocks;
+    std::vector<cugl::Vec2> _penguinFinishBlocks;
+
+    cugl::Vec2 _bearPos;
+    cugl::Vec2 _penguinPos;
+    bool _bearFinished;
+    bool _penguinFinished;
+
+    int _bearMoves;
+    int _penguinMoves;
+    /** Whether both animals ever reached their destinations in the same move */
+    bool _together;
+
+    /** Target moves from the level file, for the score */
+    int _bearPar;
+    int _penguinPar;
+
+    bool isFinish(const cugl::Vec2& pos, bool isPenguin) const;
+    bool canStand(const cugl::Vec2& pos, bool isPenguin) const;
+    bool checkForSqueeze(const cugl::Vec2& direction, bool& bearRear, std::vector<cugl::Vec2>& breaks) const;
+    bool checkNoSqueezeBlocks() const;
+    cugl::Vec2 slide(const cugl::Vec2& start, bool isPenguin, bool canBreak, const cugl::Vec2& direction,
+                     std::vector<cugl::Vec2>& breaks) const;
+    cugl::Vec2 computeTarget(const cugl::Vec2& start, bool isPenguin, bool canBreak,
+                             const cugl::Vec2& direction,
+                             const cugl::Vec2& otherStart,
+                             const cugl::Vec2& otherTarget,
+                             std::vector<cugl::Vec2>& breaks) const;
+
+public:
+    PuzzleBoard();
+
+    /** Sets up the board at the start of a level */
+    void load(const LevelData& data);
+
+    /**
+     * Swaps in an edited version of the level being played.
+     *
+     * Each animal stays where it stands if it still may stand there, and
+     * otherwise goes back to its start. Move counts carry over, as do
+     * blocks already broken where the edit still has a breakable block.
+     */
+    void reload(const LevelData& data);
+
+    /**
+     * Returns where a swipe would send the animals, without moving them.
+     *
+     * An animal that is not to move (in co-op, the other player's) holds
+     * still as if it were already on its finish.
+     */
+    Move plan(const cugl::Vec2& direction, bool moveBear = true, bool movePenguin = true) const;
+
+    /** Moves the animals to a planned move's targets and breaks its blocks */
+    Result apply(const Move& move);
+
+    /** Returns 0-3 stars: one per animal within its target moves, one for finishing together */
+    int getScore() const;
+
+    const std::vector<std::vector<int>>& getGrid() const { return _grid; }
+    int getCell(int x, int y) const { return _grid[x][y]; }
+    const cugl::Vec2& getBearPos() const { return _bearPos; }
+    const cugl::Vec2& getPenguinPos() const { return _penguinPos; }
+    bool isBearFinished() const { return _bearFinished; }
+    bool isPenguinFinished() const { return _penguinFinished; }
+    bool isWon() const { return _bearFinished && _penguinFinished; }
+    int getBearMoves() const { return _bearMoves; }
+    int getPenguinMoves() const { return _penguinMoves; }
+    int getBearPar() const { return _bearPar; }
+    int getPenguinPar() const { return _penguinPar; }
+    bool isTogether() const { return _together; }
+};
+
+#endif /* __PUZZLE_BOARD_H__ */
@@ -0,0 +1,125 @@
+//
+//  SoundEvents.cpp
+//  PolarPairs
+//
+
+#include "SoundEvents.h"
+#include <cugl/audio/CUAudioEngine.h>
+
+using namespace cugl;
+
+// Indexed by Event
+const SoundEvents::Spec SoundEvents::SPECS[(int)Event::COUNT] = {
+    { "buttonSound",        "buttonPress",   0.8f, 2, 0.05f },
+    { "moveSound",          "move",          0.8f, 1, 0.08f },
+    { "blockedSound",       "blocked",       0.8f, 1, 0.08f },
+    { "squeezeSound",       "squeeze",       0.8f, 1, 0.08f },
+    { "iceBreakSound",      "iceBreak",      0.6f, 3, 0.04f },
+    { "finishBlockSound",   "finishBlock",   1.0f, 2, 0.02f },
+    { "levelCompleteSound", "levelComplete", 0.8f, 1, 0.5f  }
+};
+
+bool SoundEvents::init(const std::shared_ptr<AssetManager>& assets, const std::string& prefix) {
+    if (!assets) {
+        return false;
+    }
+    _clock = 0;
+    _played = 0;
+    _coalesced = 0;
+    _stolen = 0;
+    for (int i = 0; i < (int)Event::COUNT; i++) {
+        const Spec& spec = SPECS[i];
+        Channel& channel = _channels[i];
+        channel = Channel();
+        channel.sound = assets->get<audio::Sound>(spec.asset);
+        for (int v = 0; v < spec.voices; v++) {
+            channel.keys.push_back(prefix + spec.name + std::to_string(v));
+            channel.started.push_back(0.0f);
+        }
+    }
+    return true;
+}
+
+void SoundEvents::dispose() {
+    for (Channel& channel : _channels) {
+        channel = Channel();
+    }
+}
+
+int SoundEvents::countActive() const {
+    auto engine = audio::AudioEngine::get();
+    int active = 0;
+    for (const Channel& channel : _channels) {
+        for (const std::string& key : channel.keys) {
+            if (engine->isActive(key)) {
+                active++;
+            }
+        }
+    }
+    return active;
+}
+
+bool SoundEvents::stealOldest() {
+    auto engine = audio::AudioEngine::get();
+    const std::string* victim = nullptr;
+    float oldest = 0;
+    for (const Channel& channel : _channels) {
+        for (size_t v = 0; v < channel.keys.size(); v++) {
+            if (engine->isActive(channel.keys[v]) && (!victim || channel.started[v] < oldest)) {
+                victim = &channel.keys[v];
+                oldest = channel.started[v];
+            }
+        }
+    }
+    if (!victim) {
+        return false;
+    }
+    engine->clear(*victim);
+    _stolen++;
+    return true;
+}
+
+bool SoundEvents::play(Event event) {
+    const Spec& spec = SPECS[(int)event];
+    Channel& channel = _channels[(int)event];
+    if (!channel.sound) {
+        return false;
+    }
+
+    // Several triggers in one burst sound like one
+    if (_clock - channel.lastPlay < spec.coalesce) {
+        _coalesced++;
+        return false;
+    }
+    channel.lastPlay = _clock;
+
+    // Use an idle voice of this event, or restart its oldest one
+    auto engine = audio::AudioEngine::get();
+    int slot = -1;
+    int oldest = 0;
+    for (int v = 0; v < (int)channel.keys.size(); v++) {
+        if (!engine->isActive(channel.keys[v])) {
+            slot = v;
+            break;
+        }
+        if (channel.started[v] < channel.started[oldest]) {
+            oldest = v;
+        }
+    }
+    if (slot < 0) {
+        slot = oldest;
+        _stolen++;
+    } else if (countActive() >= MAX_VOICES) {
+        stealOldest();
+    }
+
+    channel.started[slot] = _clock;
+    _played++;
+    return engine->play(channel.keys[slot], channel.sound, false, spec.volume, true);
+}
+
+std::string SoundEvents::getReport() const {
+    char text[96];
+    snprintf(text, sizeof(text), "sounds played %d, coalesced %d, stolen %d", _played, _coalesced, _stolen);
+    return text;
+}
@@ -0,0 +1,107 @@
+//
+//  SoundEvents.h
+//  PolarPairs
+//
+
+#ifndef __SOUND_EVENTS_H__
+#define __SOUND_EVENTS_H__
+
+#include <cugl/cugl.h>
+#include <string>
+#include <vector>
+
+/**
+ * Plays the game's sound effects by event instead of by asset key.
+ *
+ * Sound handles and voice keys are resolved once in init(), so a trigger
+ * is a table lookup rather than a string-keyed asset lookup. Each event
+ * owns a few voices: a trigger within the coalescing window of the last
+ * one is dropped, a trigger with every voice busy restarts the oldest,
+ * and when the total voice cap is reached the oldest voice of any event is
+ * stopped first. Chained breaks and finish events therefore never queue
+ * more audio work than the caps allow.
+ */
+class SoundEvents {
+public:
+    /** The sound events, one per effect */
+    enum class Event {
+        BUTTON,
+        MOVE,
+        BLOCKED,
+        SQUEEZE,
+        ICE_BREAK,
+        FINISH_BLOCK,
+        LEVEL_COMPLETE,
+        COUNT
+    };
+
+    /** Voices one instance may have playing at once, across all events */
+    static constexpr int MAX_VOICES = 6;
+
+private:
+    /** Static description of an event */
+    struct Spec {
+        const char* asset;     // Sound key in the asset manager
+        const char* name;      // Base of the audio engine voice keys
+        float volume;
+        int voices;            // Concurrent voices for this event
+        float coalesce;        // Seconds in which a repeat trigger is dropped
+    };
+    static const Spec SPECS[(int)Event::COUNT];
+
+    /** Resolved state of an event */
+    struct Channel {
+        std::shared_ptr<cugl::audio::Sound> sound;
+        std::vector<std::string> keys;
+        std::vector<float> started;
+        float lastPlay;
+        Channel() : lastPlay(-1000.0f) {}
+    };
+    Channel _channels[(int)Event::COUNT];
+
+    /** Seconds since init, advanced by update() */
+    float _clock;
+
+    // Counters for the report
+    int _played;
+    int _coalesced;
+    int _stolen;
+
+    /** Stops the oldest playing voice of any event; returns false if none is playing */
+    bool stealOldest();
+
+    /** Returns the number of voices currently playing */
+    int countActive() const;
+
+public:
+    SoundEvents() : _clock(0), _played(0), _coalesced(0), _stolen(0) {}
+    ~SoundEvents() { dispose(); }
+
+    /**
+     * Resolves the sound handles and voice keys.
+     *
+     * The prefix keeps the voice keys of separate instances apart. Events
+     * whose sound is not loaded stay silent.
+     */
+    bool init(const std::shared_ptr<cugl::AssetManager>& assets, const std::string& prefix);
+
+    /** Releases the sound handles */
+    void dispose();
+
+    /** Advances the coalescing clock */
+    void update(float timestep) { _clock += timestep; }
+
+    /** Triggers an event; returns false if it was coalesced or has no sound */
+    bool play(Event event);
+
+    /** Returns a one-line summary of played, coalesced and stolen triggers */
+    std::string getReport() const;
+
+    /** Returns true if anything was triggered since the counters were last reset */
+    bool hasReport() const { return _played + _coalesced > 0; }
+
+    /** Zeroes the report counters, e.g. between levels */
+    void resetReport() { _played = _coalesced = _stolen = 0; }
+};
+
+#endif /* __SOUND_EVENTS_H__ */
@@ -0,0 +1,334 @@
+//
+//  StatsLog.cpp
+//  PolarPairs
+//
+
+#include "StatsLog.h"
+#include "ProgressStore.h"
+#include "ProgressWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+
+/** File signatures */
+static const char LOG_MAGIC[4] = { 'P', 'P', 'S', 'L' };
+static const char TOTALS_MAGIC[4] = { 'P', 'P', 'S', 'A' };
+
+/** Bytes per level in the totals file */
+static const size_t TOTALS_ENTRY_BYTES = 2 + 6 * 4 + 8 + 4 * 4;
+
+/** Appends a little-endian value */
+static void put(std::string& data, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        data.push_back((char)((value >> (8 * i)) & 0xff));
+    }
+}
+
+/** Reads a little-endian value and advances past it */
+static uint64_t get(const uint8_t* bytes, size_t& pos, int count) {
+    uint64_t value = 0;
+    for (int i = 0; i < count; i++) {
+        value |= (uint64_t)bytes[pos++] << (8 * i);
+    }
+    return value;
+}
+
+/** Reads the whole file; returns false if it cannot be opened */
+static bool readFile(const std::string& path, std::string& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/** Returns the log header for a generation */
+static std::string logHeader(uint32_t generation) {
+    std::string data(LOG_MAGIC, sizeof(LOG_MAGIC));
+    put(data, StatsLog::VERSION, 2);
+    put(data, 0, 2);
+    put(data, generation, 4);
+    return data;
+}
+
+void StatsLog::apply(std::map<int, LevelStats>& totals, const Record& record) {
+    LevelStats& stats = totals[record.level];
+    switch (record.event) {
+        case Event::START:
+            stats.attempts++;
+            break;
+        case Event::RESTART:
+            stats.attempts++;
+            stats.restarts++;
+            break;
+        case Event::WIN:
+            stats.wins++;
+            stats.totalWinTimeMs += record.playMs;
+            if (stats.bestTimeMs == 0 || record.playMs < stats.bestTimeMs) {
+                stats.bestTimeMs = std::max(1u, record.playMs);
+            }
+            if (stats.bestMoves == 0 || record.moves < stats.bestMoves) {
+                stats.bestMoves = record.moves;
+            }
+            stats.starCounts[std::min<int>(record.stars, 3)]++;
+            break;
+        case Event::QUIT:
+            stats.quits++;
+            break;
+    }
+}
+
+bool StatsLog::loadTotals() {
+    std::string data;
+    if (!readFile(_totalsPath, data)) {
+        return false;
+    }
+
+    const uint8_t* bytes = (const uint8_t*)data.data();
+    size_t size = data.size();
+    if (size < sizeof(TOTALS_MAGIC) + 12 || std::memcmp(bytes, TOTALS_MAGIC, sizeof(TOTALS_MAGIC)) != 0) {
+        CULog("Stats totals file is not valid: %s", _totalsPath.c_str());
+        return false;
+    }
+
+    size_t pos = size - 4;
+    if (get(bytes, pos, 4) != ProgressStore::crc32(bytes, size - 4)) {
+        CULog("Stats totals file fails its checksum: %s", _totalsPath.c_str());
+        return false;
+    }
+
+    pos = sizeof(TOTALS_MAGIC);
+    if (get(bytes, pos, 2) != VERSION) {
+        return false;
+    }
+    size_t count = (size_t)get(bytes, pos, 2);
+    uint32_t generation = (uint32_t)get(bytes, pos, 4);
+    if (pos + count * TOTALS_ENTRY_BYTES + 4 != size) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        int level = (int)get(bytes, pos, 2);
+        LevelStats& stats = _committed[level];
+        stats.attempts = (uint32_t)get(bytes, pos, 4);
+        stats.restarts = (uint32_t)get(bytes, pos, 4);
+        stats.wins = (uint32_t)get(bytes, pos, 4);
+        stats.quits = (uint32_t)get(bytes, pos, 4);
+        stats.bestTimeMs = (uint32_t)get(bytes, pos, 4);
+        stats.bestMoves = (uint32_t)get(bytes, pos, 4);
+        stats.totalWinTimeMs = get(bytes, pos, 8);
+        for (int s = 0; s < 4; s++) {
+            stats.starCounts[s] = (uint32_t)get(bytes, pos, 4);
+        }
+    }
+    _generation = generation;
+    return true;
+}
+
+bool StatsLog::loadLog() {
+    std::string data;
+    if (!readFile(_logPath, data)) {
+        return false;
+    }
+
+    const uint8_t* bytes = (const uint8_t*)data.data();
+    size_t size = data.size();
+    if (size < LOG_HEADER_BYTES || std::memcmp(bytes, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0) {
+        CULog("Stats log is not valid and will be replaced: %s", _logPath.c_str());
+        return false;
+    }
+
+    size_t pos = sizeof(LOG_MAGIC);
+    if (get(bytes, pos, 2) != VERSION) {
+        return false;
+    }
+    pos += 2;
+    uint32_t generation = (uint32_t)get(bytes, pos, 4);
+    if (generation < _generation) {
+        // Folded into the totals before a crash could start the next log
+        return false;
+    }
+    _generation = generation;
+
+    while (pos + RECORD_BYTES <= size) {
+        Record record;
+        record.time = (uint32_t)get(bytes, pos, 4);
+        record.level = (uint16_t)get(bytes, pos, 2);
+        record.event = (Event)get(bytes, pos, 1);
+        record.stars = (uint8_t)get(bytes, pos, 1);
+        record.playMs = (uint32_t)get(bytes, pos, 4);
+        record.moves = (uint32_t)get(bytes, pos, 4);
+        if (record.event <= Event::QUIT) {
+            apply(_committed, record);
+        }
+    }
+    _logBytes = size;
+
+    // A torn final record means a crash mid-append; compacting drops it
+    return pos == size;
+}
+
+bool StatsLog::append(const std::vector<Record>& records) {
+    std::string data;
+    data.reserve(records.size() * RECORD_BYTES);
+    for (const auto& record : records) {
+        put(data, record.time, 4);
+        put(data, record.level, 2);
+        put(data, (uint8_t)record.event, 1);
+        put(data, record.stars, 1);
+        put(data, record.playMs, 4);
+        put(data, record.moves, 4);
+    }
+
+    FILE* file = std::fopen(_logPath.c_str(), "ab");
+    if (!file) {
+        CULog("Could not open stats log at: %s", _logPath.c_str());
+        return false;
+    }
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        CULog("Could not append to stats log: %s", _logPath.c_str());
+        return false;
+    }
+
+    for (const auto& record : records) {
+        apply(_committed, record);
+    }
+    _logBytes += data.size();
+    return true;
+}
+
+bool StatsLog::compact() {
+    uint32_t generation = _generation + 1;
+    std::string data(TOTALS_MAGIC, sizeof(TOTALS_MAGIC));
+    put(data, VERSION, 2);
+    put(data, _committed.size(), 2);
+    put(data, generation, 4);
+    for (const auto& entry : _committed) {
+        const LevelStats& stats = entry.second;
+        put(data, entry.first, 2);
+        put(data, stats.attempts, 4);
+        put(data, stats.restarts, 4);
+        put(data, stats.wins, 4);
+        put(data, stats.quits, 4);
+        put(data, stats.bestTimeMs, 4);
+        put(data, stats.bestMoves, 4);
+        put(data, stats.totalWinTimeMs, 8);
+        for (int s = 0; s < 4; s++) {
+            put(data, stats.starCounts[s], 4);
+        }
+    }
+    put(data, ProgressStore::crc32((const uint8_t*)data.data(), data.size()), 4);
+
+    // The totals go first; until the new log exists the old one is skipped by generation
+    auto start = std::chrono::steady_clock::now();
+    if (!ProgressWriter::replaceFile(_totalsPath, data)) {
+        return false;
+    }
+    _generation = generation;
+    if (!ProgressWriter::replaceFile(_logPath, logHeader(generation))) {
+        return false;
+    }
+
+    float millis = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    CULog("Compacted stats log (%zu bytes) into %zu level totals in %.1f ms",
+          _logBytes, _committed.size(), millis);
+    _logBytes = LOG_HEADER_BYTES;
+    return true;
+}
+
+bool StatsLog::start(const std::string& directory) {
+    if (_worker.joinable()) {
+        return false;
+    }
+    _logPath = directory + "stats.log";
+    _totalsPath = directory + "stats.bin";
+    _committed.clear();
+    _generation = 0;
+    _logBytes = 0;
+
+    loadTotals();
+    if (!loadLog()) {
+        compact();
+    }
+    _live = _committed;
+    CULog("Loaded stats for %zu levels (log %zu bytes, generation %u)",
+          _committed.size(), _logBytes, _generation);
+
+    _stopping = false;
+    _worker = std::thread([this] { run(); });
+    return true;
+}
+
+void StatsLog::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_worker.joinable()) {
+            return;
+        }
+        _stopping = true;
+    }
+    _wake.notify_all();
+    _worker.join();
+}
+
+void StatsLog::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _wake.wait(lock, [this] { return !_queue.empty() || _stopping; });
+        if (_queue.empty()) {
+            break;  // Stopping with nothing left to write
+        }
+
+        // Let a few records gather so one append covers them
+        if (!_stopping && _queue.size() < BATCH_SIZE) {
+            _wake.wait_for(lock, std::chrono::milliseconds(FLUSH_MS), [this] {
+                return _stopping || _queue.size() >= BATCH_SIZE;
+            });
+        }
+
+        std::vector<Record> batch;
+        batch.swap(_queue);
+        lock.unlock();
+
+        if (append(batch) && _logBytes > MAX_LOG_BYTES) {
+            compact();
+        }
+
+        lock.lock();
+    }
+}
+
+void StatsLog::record(int level, Event event, int stars, float playSeconds, int moves) {
+    if (level <= 0 || level > 0xffff) {
+        return;
+    }
+
+    Record record;
+    record.time = (uint32_t)std::time(nullptr);
+    record.level = (uint16_t)level;
+    record.event = event;
+    record.stars = (uint8_t)std::max(0, std::min(3, stars));
+    record.playMs = (uint32_t)std::max(0.0f, playSeconds * 1000.0f);
+    record.moves = (uint32_t)std::max(0, moves);
+    apply(_live, record);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _queue.push_back(record);
+    _wake.notify_one();
+}
+
+StatsLog::LevelStats StatsLog::getLevelStats(int level) const {
+    auto it = _live.find(level);
+    return it == _live.end() ? LevelStats() : it->second;
+}
+
+float StatsLog::getBestTime(int level) const {
+    return getLevelStats(level).bestTimeMs / 1000.0f;
+}
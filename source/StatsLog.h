@@ -0,0 +1,148 @@
+//
+//  StatsLog.h
+//  PolarPairs
+//
+
+#ifndef __STATS_LOG_H__
+#define __STATS_LOG_H__
+
+#include <cugl/cugl.h>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Gameplay statistics kept as an append-only event log in the save directory.
+ *
+ * Each level start, restart, win and quit is a 16 byte record. Records are
+ * queued on the main thread and appended in batches by a worker thread. When
+ * the log passes MAX_LOG_BYTES the worker folds it into per-level totals in
+ * a separate file and starts a new, empty log, so the two files stay small
+ * however long the game is played.
+ *
+ * Both files carry a generation number. The totals file records the first
+ * log generation it does not include, so a crash between writing the totals
+ * and starting the new log cannot count the old log twice.
+ *
+ * Log layout (little-endian):
+ *   magic "PPSL", u16 version, u16 unused, u32 generation
+ *   records: u32 unix time, u16 level, u8 event, u8 stars,
+ *            u32 play time in ms, u32 moves
+ *
+ * Totals layout (little-endian):
+ *   magic "PPSA", u16 version, u16 level count, u32 generation
+ *   per level: u16 level, u32 attempts, restarts, wins, quits,
+ *              best time ms, best moves, u64 total win time ms,
+ *              u32 wins with 0, 1, 2 and 3 stars
+ *   u32 CRC-32 of everything before it
+ *
+ * tools/stats/summarize_stats.py prints both files pulled from a device.
+ */
+class StatsLog {
+public:
+    /** Kinds of event */
+    enum class Event : uint8_t {
+        START = 0,
+        RESTART = 1,
+        WIN = 2,
+        QUIT = 3
+    };
+
+    /** Totals for one level */
+    struct LevelStats {
+        /** Starts and restarts */
+        uint32_t attempts = 0;
+        uint32_t restarts = 0;
+        uint32_t wins = 0;
+        uint32_t quits = 0;
+        /** Fastest and fewest-move wins (0 if never won) */
+        uint32_t bestTimeMs = 0;
+        uint32_t bestMoves = 0;
+        /** Summed play time of the wins */
+        uint64_t totalWinTimeMs = 0;
+        /** Number of wins with each star count */
+        uint32_t starCounts[4] = { 0, 0, 0, 0 };
+    };
+
+    /** Current format version of both files */
+    static constexpr uint16_t VERSION = 1;
+    /** Log size that triggers compaction */
+    static constexpr size_t MAX_LOG_BYTES = 64 * 1024;
+    /** Queued records that wake the worker before FLUSH_MS */
+    static constexpr size_t BATCH_SIZE = 32;
+    /** Milliseconds the worker waits to batch records */
+    static constexpr int FLUSH_MS = 2000;
+    /** Bytes in a log record and in the log header */
+    static constexpr size_t RECORD_BYTES = 16;
+    static constexpr size_t LOG_HEADER_BYTES = 12;
+
+private:
+    struct Record {
+        uint32_t time;
+        uint16_t level;
+        Event event;
+        uint8_t stars;
+        uint32_t playMs;
+        uint32_t moves;
+    };
+
+    std::string _logPath;
+    std::string _totalsPath;
+
+    /** Totals including queued records; main thread only */
+    std::map<int, LevelStats> _live;
+
+    std::thread _worker;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::vector<Record> _queue;
+    bool _stopping;
+
+    /** Totals of what is on disk; worker only once started */
+    std::map<int, LevelStats> _committed;
+    uint32_t _generation;
+    size_t _logBytes;
+
+    /** Adds a record to a set of totals */
+    static void apply(std::map<int, LevelStats>& totals, const Record& record);
+
+    /** Reads the totals file into _committed; returns false if missing or bad */
+    bool loadTotals();
+
+    /** Replays the log into _committed; returns false if it needs compacting */
+    bool loadLog();
+
+    /** Appends records to the log */
+    bool append(const std::vector<Record>& records);
+
+    /** Writes _committed to the totals file and starts the next log */
+    bool compact();
+
+    /** Batches and appends queued records until stopped */
+    void run();
+
+public:
+    StatsLog() : _stopping(false), _generation(0), _logBytes(0) {}
+    ~StatsLog() { stop(); }
+
+    /** Loads the totals and log from the directory and starts the worker */
+    bool start(const std::string& directory);
+
+    /** Appends any queued records and stops the worker */
+    void stop();
+
+    /** Queues an event; returns immediately */
+    void record(int level, Event event, int stars = 0, float playSeconds = 0, int moves = 0);
+
+    /** Returns the totals for a level, including queued events */
+    LevelStats getLevelStats(int level) const;
+
+    /** Returns the fastest win of a level in seconds, or 0 if never won */
+    float getBestTime(int level) const;
+};
+
+#endif /* __STATS_LOG_H__ */
@@ -0,0 +1,88 @@
+//
+//  SwipeRecognizer.cpp
+//  PolarPairs
+//
+
+#include "SwipeRecognizer.h"
+#include <algorithm>
+
+void SwipeRecognizer::init() {
+    // Touch positions are in points; the DPI is in physical pixels
+    float density = cugl::Display::get()->getPixelDensity();
+    float dpi = 0;
+    if (SDL_GetDisplayDPI(0, &dpi, nullptr, nullptr) != 0 || dpi <= 0) {
+        dpi = DEFAULT_DPI * density;
+    }
+    _mmPerUnit = 25.4f * density / dpi;
+    CULog("Swipe recognizer: %.0f dpi, %.1f mm per %.0f points commit distance",
+          dpi, COMMIT_MM, COMMIT_MM / _mmPerUnit);
+    reset();
+}
+
+cugl::Vec2 SwipeRecognizer::classify(const cugl::Vec2& delta, float minMM) const {
+    float major = std::max(std::abs(delta.x), std::abs(delta.y)) * _mmPerUnit;
+    float minor = std::min(std::abs(delta.x), std::abs(delta.y)) * _mmPerUnit;
+    if (major < minMM || major < minor * AXIS_RATIO) {
+        return cugl::Vec2::ZERO;
+    }
+
+    // Screen y grows downward; scene y grows upward
+    if (std::abs(delta.x) > std::abs(delta.y)) {
+        return cugl::Vec2(delta.x > 0 ? 1 : -1, 0);
+    }
+    return cugl::Vec2(0, delta.y > 0 ? -1 : 1);
+}
+
+cugl::Vec2 SwipeRecognizer::update(cugl::Touchscreen* touch) {
+    _justStarted = false;
+    if (!touch) {
+        return cugl::Vec2::ZERO;
+    }
+
+    const auto& fingers = touch->touchSet();
+    if (fingers.size() >= 3) {
+        _done = true;
+    }
+
+    // Lifted: a short swipe that never reached the early thresholds still counts
+    cugl::Vec2 released = cugl::Vec2::ZERO;
+    if (_tracking && std::find(fingers.begin(), fingers.end(), _touch) == fingers.end()) {
+        _tracking = false;
+        if (!_done) {
+            released = classify(_last - _start, RELEASE_MM);
+        }
+    }
+
+    if (!_tracking) {
+        // Follow a finger that just went down, never one already resting on
+        // the glass; this may be the same frame the last finger lifted
+        for (cugl::TouchID id : fingers) {
+            if (touch->touchPressed(id)) {
+                _tracking = true;
+                _justStarted = true;
+                _done = fingers.size() >= 3;
+                _touch = id;
+                _start = touch->touchPosition(id);
+                _last = _start;
+                _startTime = Clock::now();
+                break;
+            }
+        }
+        return released;
+    }
+
+    _last = touch->touchPosition(_touch);
+    if (_done) {
+        return cugl::Vec2::ZERO;
+    }
+
+    cugl::Vec2 delta = _last - _start;
+    float seconds = std::chrono::duration<float>(Clock::now() - _startTime).count();
+    float travel = delta.length() * _mmPerUnit;
+    bool flick = seconds > 0 && travel / seconds >= COMMIT_SPEED;
+    cugl::Vec2 direction = classify(delta, flick ? COMMIT_MM : FORCE_MM);
+    if (direction != cugl::Vec2::ZERO) {
+        _done = true;
+    }
+    return direction;
+}
@@ -0,0 +1,99 @@
+//
+//  SwipeRecognizer.h
+//  PolarPairs
+//
+
+#ifndef __SWIPE_RECOGNIZER_H__
+#define __SWIPE_RECOGNIZER_H__
+
+#include <cugl/cugl.h>
+#include <chrono>
+
+/**
+ * Turns touches into swipe directions while the finger is still moving.
+ *
+ * Distances are measured in millimetres on the glass, using the display
+ * DPI, so a swipe takes the same finger travel on every device. A direction
+ * is committed as soon as the finger has moved COMMIT_MM along one axis fast
+ * enough to be a flick, or FORCE_MM however slowly; a touch that lifts
+ * before either still counts if it moved RELEASE_MM. Each touch commits at
+ * most one direction.
+ *
+ * Only one finger swipes at a time. The first finger down is followed until
+ * it lifts, whatever other fingers do, and a new finger takes over only
+ * after that. Three or more fingers (the debug readout gesture) cancel the
+ * swipe.
+ */
+class SwipeRecognizer {
+public:
+    /** Travel, in mm, that commits a fast swipe */
+    static constexpr float COMMIT_MM = 3.0f;
+    /** Average speed, in mm per second, a swipe needs to commit at COMMIT_MM */
+    static constexpr float COMMIT_SPEED = 40.0f;
+    /** Travel, in mm, that commits a swipe at any speed */
+    static constexpr float FORCE_MM = 8.0f;
+    /** Travel, in mm, that still counts as a swipe when the finger lifts */
+    static constexpr float RELEASE_MM = 2.0f;
+    /** How much longer the major axis must be than the minor one */
+    static constexpr float AXIS_RATIO = 1.2f;
+    /** Dots per inch assumed when the display does not report one */
+    static constexpr float DEFAULT_DPI = 160.0f;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    /** Millimetres per screen unit of touch position */
+    float _mmPerUnit;
+
+    /** Whether a finger is being followed */
+    bool _tracking;
+    /** The finger being followed */
+    cugl::TouchID _touch;
+    /** Whether the followed finger went down this frame */
+    bool _justStarted;
+    /** Whether the followed finger has committed or been cancelled */
+    bool _done;
+    /** Screen position and time where the finger went down */
+    cugl::Vec2 _start;
+    Clock::time_point _startTime;
+    /** Last screen position seen, for the release check */
+    cugl::Vec2 _last;
+
+    /** Returns the committed direction for a move, or ZERO if it is not a swipe yet */
+    cugl::Vec2 classify(const cugl::Vec2& delta, float minMM) const;
+
+public:
+    SwipeRecognizer() : _mmPerUnit(25.4f / DEFAULT_DPI), _tracking(false), _touch(0),
+                        _justStarted(false), _done(false) {}
+
+    /** Reads the display density; call once the display exists */
+    void init();
+
+    /**
+     * Follows the touchscreen for one frame.
+     *
+     * Returns a unit direction with y up, matching scene coordinates, on
+     * the frame a swipe commits, and ZERO otherwise.
+     */
+    cugl::Vec2 update(cugl::Touchscreen* touch);
+
+    /** Ignores the followed finger until it lifts (e.g. it went down on a button) */
+    void cancel() { _done = true; }
+
+    /** Forgets the followed finger, e.g. when a menu opens mid-swipe */
+    void reset() { _tracking = false; _done = false; _justStarted = false; }
+
+    /** Returns true while a finger is being followed */
+    bool isTracking() const { return _tracking; }
+
+    /** Returns true if the followed finger went down this frame */
+    bool justStarted() const { return _justStarted; }
+
+    /** Returns the followed finger */
+    cugl::TouchID getTouch() const { return _touch; }
+
+    /** Returns the screen position where the followed finger went down */
+    const cugl::Vec2& getStart() const { return _start; }
+};
+
+#endif /* __SWIPE_RECOGNIZER_H__ */
@@ -0,0 +1,44 @@
+#ifndef __TEXTURE_ATLAS_H__
+#define __TEXTURE_ATLAS_H__
+
+#include <cugl/cugl.h>
+#include <string>
+
+/**
+ * Name-based lookup for sprites packed by tools/atlas/pack_atlas.py.
+ *
+ * The packer writes one json/atlases/<atlas>.json per atlas, holding a single
+ * texture whose regions CUGL registers as "<atlas>_<sprite>". Looking sprites up through
+ * this class keeps call sites on the short sprite names ("bearblock",
+ * "Restart", ...) and lets nodes that share an atlas draw from one texture.
+ */
+class TextureAtlas {
+public:
+    /** Returns the asset file holding the given atlas texture and its region map */
+    static std::string getFile(const std::string& atlas) {
+        return "json/atlases/" + atlas + ".json";
+    }
+
+    /**
+     * Returns the sub-texture for the given sprite name.
+     *
+     * Falls back to a standalone texture with the same key, so sprites that
+     * are not packed (or an asset directory without atlases) still resolve.
+     */
+    static std::shared_ptr<cugl::graphics::Texture> get(const std::shared_ptr<cugl::AssetManager>& assets,
+                                                        const std::string& name) {
+        for (const char* atlas : ATLASES) {
+            auto region = assets->get<cugl::graphics::Texture>(std::string(atlas) + "_" + name);
+            if (region) {
+                return region;
+            }
+        }
+        return assets->get<cugl::graphics::Texture>(name);
+    }
+
+private:
+    /** Atlas keys in json/atlases, most frequently used first */
+    static constexpr const char* ATLASES[] = { "gameplay", "interface", "levelbuttons" };
+};
+
+#endif /* __TEXTURE_ATLAS_H__ */
@@ -0,0 +1,52 @@
+//
+//  TextureVariants.cpp
+//  PolarPairs
+//
+
+#include "TextureVariants.h"
+
+using namespace cugl;
+
+bool TextureVariants::init(float tilePixels) {
+    _scales.clear();
+    auto reader = JsonReader::allocWithAsset(MANIFEST_FILE);
+    auto manifest = reader ? reader->readJson() : nullptr;
+    if (!manifest) {
+        CULog("No texture variant manifest; loading full-size textures");
+        return false;
+    }
+
+    for (size_t i = 0; i < manifest->size(); i++) {
+        auto entry = manifest->get((int)i);
+        float tile = entry->getFloat("tile", 0);
+        float chosen = 1.0f;
+        if (auto scales = entry->get("scales")) {
+            for (size_t j = 0; j < scales->size(); j++) {
+                float scale = scales->get((int)j)->asFloat(1.0f);
+                if (scale < chosen && tile * scale >= tilePixels) {
+                    chosen = scale;
+                }
+            }
+        }
+        _scales[entry->key()] = chosen;
+        CULog("Texture variant for %s: %gx (tile %.0f px, art covers %.0f px)",
+              entry->key().c_str(), chosen, tilePixels, tile);
+    }
+    return true;
+}
+
+float TextureVariants::getScale(const std::string& file) const {
+    auto it = _scales.find(file);
+    return it == _scales.end() ? 1.0f : it->second;
+}
+
+std::string TextureVariants::getFile(const std::string& file) const {
+    float scale = getScale(file);
+    size_t dot = file.rfind('.');
+    if (scale >= 1.0f || dot == std::string::npos) {
+        return file;
+    }
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), "@%gx", scale);
+    return file.substr(0, dot) + suffix + file.substr(dot);
+}
@@ -0,0 +1,47 @@
+//
+//  TextureVariants.h
+//  PolarPairs
+//
+
+#ifndef __TEXTURE_VARIANTS_H__
+#define __TEXTURE_VARIANTS_H__
+
+#include <cugl/cugl.h>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Picks the downscaled asset files that suit this display.
+ *
+ * tools/atlas/pack_atlas.py writes half and quarter size copies of the
+ * texture asset files (json/menu@0.5x.json, ...) and a manifest giving, for
+ * each file, the tile size in pixels at which its full-size art is drawn
+ * 1:1. Every sprite is scaled from its texture size, so a smaller variant
+ * only changes how many texels back each on-screen pixel.
+ */
+class TextureVariants {
+public:
+    /** Manifest written by the atlas tool */
+    static constexpr const char* MANIFEST_FILE = "json/variants.json";
+
+private:
+    /** Chosen scale per asset file; files not listed load at full size */
+    std::unordered_map<std::string, float> _scales;
+
+public:
+    /**
+     * Reads the manifest and chooses a variant for each file.
+     *
+     * Each file gets the smallest scale whose art still covers the given
+     * tile size in pixels, or full size if none does.
+     */
+    bool init(float tilePixels);
+
+    /** Returns the scale chosen for the asset file (1 if it has no variants) */
+    float getScale(const std::string& file) const;
+
+    /** Returns the variant path to load in place of the asset file */
+    std::string getFile(const std::string& file) const;
+};
+
+#endif /* __TEXTURE_VARIANTS_H__ */
@@ -0,0 +1,168 @@
+//
+//  TweenEngine.cpp
+//  PolarPairs
+//
+
+#include "TweenEngine.h"
+#include <algorithm>
+
+void TweenEngine::apply(cugl::scene2::SceneNode* target, Property property, float value) {
+    switch (property) {
+        case Property::POSITION_X:
+            target->setPositionX(value);
+            break;
+        case Property::POSITION_Y:
+            target->setPositionY(value);
+            break;
+        case Property::SCALE:
+            target->setScale(value);
+            break;
+        case Property::ALPHA: {
+            cugl::Color4 color = target->getColor();
+            color.a = static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, value)));
+            target->setColor(color);
+            break;
+        }
+        case Property::FRAME: {
+            auto sprite = static_cast<cugl::scene2::SpriteNode*>(target);
+            int frame = std::min(static_cast<int>(value), sprite->getCount() - 1);
+            if (frame != sprite->getFrame()) {
+                sprite->setFrame(frame);
+            }
+            break;
+        }
+    }
+}
+
+float TweenEngine::ease(Easing easing, float t) {
+    switch (easing) {
+        case Easing::EASE_OUT_CUBIC: {
+            float inv = 1.0f - t;
+            return 1.0f - inv * inv * inv;
+        }
+        case Easing::PING_PONG:
+            return t < 0.5f ? t * 2.0f : (1.0f - t) * 2.0f;
+        case Easing::LINEAR:
+        default:
+            return t;
+    }
+}
+
+void TweenEngine::reserve(size_t count) {
+    _targets.reserve(count);
+    _properties.reserve(count);
+    _starts.reserve(count);
+    _ends.reserve(count);
+    _durations.reserve(count);
+    _elapsed.reserve(count);
+    _easings.reserve(count);
+    _events.reserve(count);
+    _data.reserve(count);
+}
+
+void TweenEngine::add(const std::shared_ptr<cugl::scene2::SceneNode>& target, Property property,
+                      float start, float end, float duration,
+                      Easing easing, int event, int data) {
+    if (!target) {
+        return;
+    }
+
+    _targets.push_back(target);
+    _properties.push_back(property);
+    _starts.push_back(start);
+    _ends.push_back(end);
+    _durations.push_back(duration);
+    _elapsed.push_back(0.0f);
+    _easings.push_back(easing);
+    _events.push_back(event);
+    _data.push_back(data);
+
+    apply(target.get(), property, start);
+}
+
+bool TweenEngine::isActive(const std::shared_ptr<cugl::scene2::SceneNode>& target, Property property) const {
+    for (size_t i = 0; i < _targets.size(); i++) {
+        if (_targets[i] == target && _properties[i] == property) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TweenEngine::removeAt(size_t index) {
+    size_t last = _targets.size() - 1;
+    if (index != last) {
+        _targets[index] = std::move(_targets[last]);
+        _properties[index] = _properties[last];
+        _starts[index] = _starts[last];
+        _ends[index] = _ends[last];
+        _durations[index] = _durations[last];
+        _elapsed[index] = _elapsed[last];
+        _easings[index] = _easings[last];
+        _events[index] = _events[last];
+        _data[index] = _data[last];
+    }
+    _targets.pop_back();
+    _properties.pop_back();
+    _starts.pop_back();
+    _ends.pop_back();
+    _durations.pop_back();
+    _elapsed.pop_back();
+    _easings.pop_back();
+    _events.pop_back();
+    _data.pop_back();
+}
+
+void TweenEngine::complete(size_t index) {
+    int event = _events[index];
+    if (event == NO_EVENT || !_listener) {
+        removeAt(index);
+        return;
+    }
+    // Remove first: the listener may start new tweens
+    std::shared_ptr<cugl::scene2::SceneNode> target = _targets[index];
+    int data = _data[index];
+    removeAt(index);
+    _listener(target, event, data);
+}
+
+void TweenEngine::update(float dt) {
+    // Advance every tween and write its value
+    size_t count = _targets.size();
+    for (size_t i = 0; i < count; i++) {
+        _elapsed[i] += dt;
+        float t = _durations[i] > 0 ? std::min(1.0f, _elapsed[i] / _durations[i]) : 1.0f;
+        float value = _starts[i] + (_ends[i] - _starts[i]) * ease(_easings[i], t);
+        apply(_targets[i].get(), _properties[i], value);
+    }
+
+    // Complete finished tweens. Walking backwards means the tween swapped into
+    // a freed slot has already been checked this frame.
+    for (size_t i = count; i-- > 0; ) {
+        if (_elapsed[i] < _durations[i]) {
+            continue;
+        }
+        complete(i);
+    }
+}
+
+void TweenEngine::finishAll() {
+    while (!_targets.empty()) {
+        size_t last = _targets.size() - 1;
+        float end = _starts[last] + (_ends[last] - _starts[last]) * ease(_easings[last], 1.0f);
+        apply(_targets[last].get(), _properties[last], end);
+        complete(last);
+    }
+}
+
+void TweenEngine::clear() {
+    _targets.clear();
+    _properties.clear();
+    _starts.clear();
+    _ends.clear();
+    _durations.clear();
+    _elapsed.clear();
+    _easings.clear();
+    _events.clear();
+    _data.clear();
+}
@@ -0,0 +1,109 @@
+//
+//  TweenEngine.h
+//  PolarPairs
+//
+
+#ifndef __TWEEN_ENGINE_H__
+#define __TWEEN_ENGINE_H__
+
+#include <cugl/cugl.h>
+#include <functional>
+#include <vector>
+
+/**
+ * Drives every scene node animation with one batched update.
+ *
+ * Each tween interpolates a single property of a node from a start value to
+ * an end value. Tweens are stored as a structure of arrays so the per-frame
+ * update walks contiguous data, and a finished tween is removed in O(1) by
+ * swapping the last tween into its place.
+ *
+ * A tween can carry a completion event: an id and an int of data, passed to
+ * the listener when the tween ends. Keeping these as plain values rather
+ * than a closure per tween means starting an effect never allocates once
+ * the arrays have been reserved.
+ */
+class TweenEngine {
+public:
+    /** The node property a tween writes */
+    enum class Property {
+        POSITION_X,
+        POSITION_Y,
+        SCALE,
+        ALPHA,   // Color alpha, 0 to 255
+        FRAME    // SpriteNode frame; the target must be a SpriteNode
+    };
+
+    /** How progress (0 to 1) maps onto the start-end range */
+    enum class Easing {
+        LINEAR,
+        EASE_OUT_CUBIC,
+        PING_PONG        // Out to the end value at halfway, then back to start
+    };
+
+    /** Event id of a tween that reports nothing when it ends */
+    static const int NO_EVENT = 0;
+
+    /** Called after a tween with an event writes its final value */
+    using Listener = std::function<void(const std::shared_ptr<cugl::scene2::SceneNode>& target, int event, int data)>;
+
+private:
+    std::vector<std::shared_ptr<cugl::scene2::SceneNode>> _targets;
+    std::vector<Property> _properties;
+    std::vector<float> _starts;
+    std::vector<float> _ends;
+    std::vector<float> _durations;
+    std::vector<float> _elapsed;
+    std::vector<Easing> _easings;
+    std::vector<int> _events;
+    std::vector<int> _data;
+
+    /** Receives the events of completed tweens */
+    Listener _listener;
+
+    /** Writes a property value to a node */
+    static void apply(cugl::scene2::SceneNode* target, Property property, float value);
+
+    /** Maps linear progress through an easing curve */
+    static float ease(Easing easing, float t);
+
+    /** Removes the tween at index by moving the last tween into its slot */
+    void removeAt(size_t index);
+
+    /** Removes the tween at index and passes its event, if any, to the listener */
+    void complete(size_t index);
+
+public:
+    /** Sets the function that receives completion events */
+    void setListener(const Listener& listener) { _listener = listener; }
+
+    /** Makes room for count running tweens, so adding up to that many does not allocate */
+    void reserve(size_t count);
+
+    /**
+     * Starts a tween and writes its start value immediately.
+     *
+     * A duration of zero completes the tween on the next update. If event is
+     * not NO_EVENT, the listener gets event and data when the tween ends.
+     */
+    void add(const std::shared_ptr<cugl::scene2::SceneNode>& target, Property property,
+             float start, float end, float duration,
+             Easing easing = Easing::LINEAR, int event = NO_EVENT, int data = 0);
+
+    /** Returns true if the node has a running tween on the given property */
+    bool isActive(const std::shared_ptr<cugl::scene2::SceneNode>& target, Property property) const;
+
+    /** Advances every tween and completes the ones that have run their duration */
+    void update(float dt);
+
+    /** Snaps every tween to its end value and reports its event */
+    void finishAll();
+
+    /** Drops every tween without writing end values or reporting events */
+    void clear();
+
+    /** Returns the number of running tweens */
+    size_t size() const { return _targets.size(); }
+};
+
+#endif /* __TWEEN_ENGINE_H__ */
@@ -26,7 +26,7 @@ int main(int argc, char * argv[]) {
     
     // REMOVED: app.setScaleMode(ScaleMode::LETTERBOX);
     
-    app.setFPS(60.0f);
+    app.setFPS(FrameGovernor::RATES[0]);
     app.setHighDPI(true);
     
     // Initialize and run the application
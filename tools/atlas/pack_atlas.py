@@ -0,0 +1,436 @@
+#!/usr/bin/env python3
+#
+#  pack_atlas.py
+#  PolarPairs
+#
+#  Offline texture atlas packer. Reads the atlas spec (atlases.json next to
+#  this script), packs every listed PNG into one image per atlas and writes
+#  each atlas's CUGL region map to assets/json/atlases/<atlas>.json.
+#
+#  Each atlas becomes a single texture entry with an "atlas" block, so CUGL
+#  registers every region as "<atlas>_<sprite>". Atlases get their own asset
+#  file so the game can load and unload them with the asset group of the
+#  scene that uses them. The game resolves sprites through TextureAtlas::get(),
+#  which falls back to the standalone texture when a sprite is not packed.
+#
+#  The tool also writes downscaled variants. Atlases with "scales" in their
+#  spec are repacked from downscaled sprites, and the standalone asset files
+#  listed in variants.json get copies that point at downscaled PNGs. Each
+#  variant is written next to its source as <name>@<scale>x.json, with the
+#  same keys. "tile" is the on-screen tile size, in pixels, at which the
+#  full-size art is drawn 1:1. The game reads the json/variants.json
+#  manifest and loads the smallest variant that still covers its tile size.
+#
+#  Only the Python standard library is used, so the tool runs anywhere the
+#  repo is checked out:
+#
+#      python3 tools/atlas/pack_atlas.py [atlas or asset file ...]
+#
+import json
+import os
+import re
+import struct
+import sys
+import zlib
+
+TOOL_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.normpath(os.path.join(TOOL_DIR, "..", ".."))
+ASSET_DIR = os.path.join(REPO_DIR, "assets")
+SPEC_FILE = os.path.join(TOOL_DIR, "atlases.json")
+VARIANT_SPEC_FILE = os.path.join(TOOL_DIR, "variants.json")
+REGION_DIR = os.path.join(ASSET_DIR, "json", "atlases")
+MANIFEST_FILE = os.path.join(ASSET_DIR, "json", "variants.json")
+VARIANT_DIR = "textures/variants"
+
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+
+
+# PNG I/O
+
+def read_png(path):
+    """Decodes an 8-bit, non-interlaced PNG into (width, height, RGBA bytes)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != PNG_SIGNATURE:
+        raise ValueError("%s is not a PNG file" % path)
+
+    pos = 8
+    idat = []
+    width = height = depth = ctype = interlace = 0
+    palette = None
+    trns = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = chunk
+        elif kind == b"tRNS":
+            trns = chunk
+        elif kind == b"IDAT":
+            idat.append(chunk)
+        elif kind == b"IEND":
+            break
+
+    if depth != 8 or interlace != 0:
+        raise ValueError("%s: only 8-bit non-interlaced PNGs are supported" % path)
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(ctype)
+    if channels is None:
+        raise ValueError("%s: unsupported color type %d" % (path, ctype))
+
+    raw = zlib.decompress(b"".join(idat))
+    stride = width * channels
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        ftype = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        unfilter(ftype, line, prev, channels)
+        rows.append(line)
+        prev = line
+
+    out = bytearray(width * height * 4)
+    o = 0
+    for line in rows:
+        if ctype == 6:
+            out[o:o + stride] = line
+            o += stride
+            continue
+        for i in range(width):
+            if ctype == 2:
+                r, g, b = line[3 * i:3 * i + 3]
+                a = 255
+            elif ctype == 0:
+                r = g = b = line[i]
+                a = 255
+            elif ctype == 4:
+                r = g = b = line[2 * i]
+                a = line[2 * i + 1]
+            else:
+                idx = line[i]
+                r, g, b = palette[3 * idx:3 * idx + 3]
+                a = trns[idx] if trns is not None and idx < len(trns) else 255
+            out[o:o + 4] = bytes((r, g, b, a))
+            o += 4
+    return width, height, out
+
+
+def unfilter(ftype, line, prev, bpp):
+    """Reverses one PNG scanline filter in place."""
+    n = len(line)
+    if ftype == 0:
+        return
+    if ftype == 1:
+        for i in range(bpp, n):
+            line[i] = (line[i] + line[i - bpp]) & 0xFF
+    elif ftype == 2:
+        for i in range(n):
+            line[i] = (line[i] + prev[i]) & 0xFF
+    elif ftype == 3:
+        for i in range(n):
+            left = line[i - bpp] if i >= bpp else 0
+            line[i] = (line[i] + ((left + prev[i]) >> 1)) & 0xFF
+    elif ftype == 4:
+        for i in range(n):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            p = a + b - c
+            pa = abs(p - a)
+            pb = abs(p - b)
+            pc = abs(p - c)
+            if pa <= pb and pa <= pc:
+                pred = a
+            elif pb <= pc:
+                pred = b
+            else:
+                pred = c
+            line[i] = (line[i] + pred) & 0xFF
+    else:
+        raise ValueError("bad PNG filter type %d" % ftype)
+
+
+def write_png(path, width, height, rgba):
+    """Encodes RGBA bytes as a PNG, picking the Sub or Up filter per row when it helps."""
+    stride = width * 4
+    raw = bytearray()
+    prev = bytes(stride)
+    for y in range(height):
+        line = rgba[y * stride:(y + 1) * stride]
+        sub = bytes(line[:4]) + bytes((a - b) & 0xFF for a, b in zip(line[4:], line[:-4]))
+        up = bytes((a - b) & 0xFF for a, b in zip(line, prev))
+        # Minimum sum of absolute differences, the usual libpng heuristic
+        cost = lambda row: sum(v if v < 128 else 256 - v for v in row)
+        candidates = [(cost(line), 0, line), (cost(sub), 1, sub), (cost(up), 2, up)]
+        _, ftype, body = min(candidates, key=lambda c: c[0])
+        raw.append(ftype)
+        raw += body
+        prev = line
+
+    def chunk(kind, body):
+        crc = zlib.crc32(kind + body) & 0xFFFFFFFF
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", crc)
+
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "wb") as f:
+        f.write(PNG_SIGNATURE)
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 6, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(bytes(raw), 9)))
+        f.write(chunk(b"IEND", b""))
+
+
+# Downscaling
+
+def downscale(width, height, rgba, factor):
+    """
+    Shrinks RGBA pixels by an integer factor with a box filter.
+
+    Colors are averaged weighted by alpha, so transparent pixels do not darken
+    the edges of sprites. Partial boxes at the right and bottom edges average
+    the pixels they have.
+    """
+    out_w = (width + factor - 1) // factor
+    out_h = (height + factor - 1) // factor
+    out = bytearray(out_w * out_h * 4)
+    o = 0
+    for oy in range(out_h):
+        y0 = oy * factor
+        y1 = min(y0 + factor, height)
+        for ox in range(out_w):
+            x0 = ox * factor
+            x1 = min(x0 + factor, width)
+            r = g = b = a = count = 0
+            for y in range(y0, y1):
+                i = (y * width + x0) * 4
+                for _ in range(x0, x1):
+                    alpha = rgba[i + 3]
+                    r += rgba[i] * alpha
+                    g += rgba[i + 1] * alpha
+                    b += rgba[i + 2] * alpha
+                    a += alpha
+                    count += 1
+                    i += 4
+            if a > 0:
+                out[o:o + 4] = bytes(((r + a // 2) // a, (g + a // 2) // a, (b + a // 2) // a,
+                                      (a + count // 2) // count))
+            o += 4
+    return out_w, out_h, out
+
+
+def scale_factor(scale):
+    """Returns the integer shrink factor for a variant scale (0.5 -> 2)."""
+    factor = int(round(1.0 / scale))
+    if factor < 2 or abs(1.0 / factor - scale) > 1e-6:
+        raise ValueError("variant scale %g is not 1/n for an integer n >= 2" % scale)
+    return factor
+
+
+def variant_path(path, scale):
+    """Returns the path of a variant: json/menu.json -> json/menu@0.5x.json."""
+    root, ext = os.path.splitext(path)
+    return "%s@%gx%s" % (root, scale, ext)
+
+
+# Packing
+
+class MaxRects:
+    """MaxRects bin packer using the best-short-side-fit heuristic."""
+
+    def __init__(self, width, height):
+        self.free = [(0, 0, width, height)]
+
+    def insert(self, w, h):
+        best = None
+        for fx, fy, fw, fh in self.free:
+            if w <= fw and h <= fh:
+                score = (min(fw - w, fh - h), max(fw - w, fh - h))
+                if best is None or score < best[0]:
+                    best = (score, fx, fy)
+        if best is None:
+            return None
+        _, x, y = best
+        self._split(x, y, w, h)
+        return x, y
+
+    def _split(self, x, y, w, h):
+        result = []
+        for fx, fy, fw, fh in self.free:
+            if x >= fx + fw or x + w <= fx or y >= fy + fh or y + h <= fy:
+                result.append((fx, fy, fw, fh))
+                continue
+            if x > fx:
+                result.append((fx, fy, x - fx, fh))
+            if x + w < fx + fw:
+                result.append((x + w, fy, fx + fw - x - w, fh))
+            if y > fy:
+                result.append((fx, fy, fw, y - fy))
+            if y + h < fy + fh:
+                result.append((fx, y + h, fw, fy + fh - y - h))
+        # Drop rectangles contained in another free rectangle
+        pruned = []
+        for i, a in enumerate(result):
+            contained = False
+            for j, b in enumerate(result):
+                if i != j and a[0] >= b[0] and a[1] >= b[1] and \
+                        a[0] + a[2] <= b[0] + b[2] and a[1] + a[3] <= b[1] + b[3]:
+                    if a != b or i > j:
+                        contained = True
+                        break
+            if not contained:
+                pruned.append(a)
+        self.free = pruned
+
+
+def pack(sprites, padding, maxsize):
+    """
+    Finds the page with the least area that holds every sprite.
+
+    Each candidate width is packed into a page maxsize tall, and the page is
+    then trimmed to the lowest placed sprite (rounded up to a multiple of 4).
+    """
+    order = sorted(sprites, key=lambda s: (max(s[1], s[2]), s[1] * s[2]), reverse=True)
+    widest = max(w for _, w, _, _ in sprites) + 2 * padding
+
+    best = None
+    width = (widest + 3) & ~3
+    while width <= maxsize:
+        packer = MaxRects(width, maxsize)
+        placed = {}
+        bottom = 0
+        for name, w, h, _ in order:
+            spot = packer.insert(w + 2 * padding, h + 2 * padding)
+            if spot is None:
+                break
+            placed[name] = (spot[0] + padding, spot[1] + padding)
+            bottom = max(bottom, spot[1] + h + 2 * padding)
+        else:
+            height = (bottom + 3) & ~3
+            if best is None or width * height < best[0] * best[1]:
+                best = (width, height, placed)
+        width += 64
+    if best is None:
+        raise ValueError("sprites do not fit in a %dx%d atlas" % (maxsize, maxsize))
+    return best
+
+
+def build_atlas(key, spec, scale=1.0):
+    padding = spec.get("padding", 2)
+    maxsize = spec.get("maxsize", 2048)
+    factor = scale_factor(scale) if scale != 1.0 else 1
+
+    sprites = []
+    source_bytes = 0
+    for name, file in spec["sprites"].items():
+        path = os.path.join(ASSET_DIR, file)
+        w, h, pixels = read_png(path)
+        if factor > 1:
+            w, h, pixels = downscale(w, h, pixels, factor)
+        sprites.append((name, w, h, pixels))
+        source_bytes += os.path.getsize(path)
+
+    width, height, placed = pack(sprites, padding, maxsize)
+    page = bytearray(width * height * 4)
+    regions = {}
+    for name, w, h, pixels in sprites:
+        x, y = placed[name]
+        for row in range(h):
+            dst = ((y + row) * width + x) * 4
+            page[dst:dst + w * 4] = pixels[row * w * 4:(row + 1) * w * 4]
+        regions[name] = [x, y, x + w, y + h]
+
+    file = spec["file"] if factor == 1 else variant_path(spec["file"], scale)
+    output = os.path.join(ASSET_DIR, file)
+    write_png(output, width, height, page)
+
+    entry = {"file": file}
+    for attr in ("minfilter", "magfilter", "wrapS", "wrapT"):
+        if attr in spec:
+            entry[attr] = spec[attr]
+    entry["atlas"] = regions
+
+    used = sum(w * h for _, w, h, _ in sprites)
+    label = key if factor == 1 else "%s@%gx" % (key, scale)
+    print("%-18s %2d sprites  %4dx%-4d  %5.1f%% used  %7d -> %7d bytes" %
+          (label, len(sprites), width, height, 100.0 * used / (width * height),
+           source_bytes, os.path.getsize(output)))
+    return entry
+
+
+def write_asset_file(path, data):
+    """Writes an asset directory file under assets/."""
+    text = json.dumps(data, indent=2)
+    # Keep number lists (regions, scales) on one line, like the hand-written atlas entries
+    text = re.sub(r"\[\s+([-\d.]+(?:,\s+[-\d.]+)*)\s+\]",
+                  lambda m: "[%s]" % ", ".join(re.split(r",\s+", m.group(1))), text)
+    with open(os.path.join(ASSET_DIR, path), "w") as f:
+        f.write(text + "\n")
+
+
+def build_variants(path, spec):
+    """Writes the downscaled variants of a standalone asset directory file."""
+    with open(os.path.join(ASSET_DIR, path)) as f:
+        source = json.load(f)
+    keep = set(spec.get("keep", []))
+
+    for scale in spec["scales"]:
+        factor = scale_factor(scale)
+        variant = json.loads(json.dumps(source))
+        before = after = 0
+        for key, entry in variant.get("textures", {}).items():
+            if key in keep:
+                continue
+            w, h, pixels = read_png(os.path.join(ASSET_DIR, entry["file"]))
+            w, h, pixels = downscale(w, h, pixels, factor)
+            name = os.path.splitext(os.path.basename(entry["file"]))[0]
+            entry["file"] = "%s/%s@%gx.png" % (VARIANT_DIR, name, scale)
+            write_png(os.path.join(ASSET_DIR, entry["file"]), w, h, pixels)
+            if spec.get("mipmaps", False):
+                entry["minfilter"] = "linear-linear"
+                entry["mipmaps"] = True
+            before += w * h * factor * factor * 4
+            after += w * h * 4
+        write_asset_file(variant_path(path, scale), variant)
+        print("%-28s %7d KB -> %7d KB" % (variant_path(path, scale), before // 1024, after // 1024))
+
+
+def main(argv):
+    with open(SPEC_FILE) as f:
+        spec = json.load(f)
+    with open(VARIANT_SPEC_FILE) as f:
+        variant_spec = json.load(f)
+    wanted = lambda key: len(argv) == 1 or key in argv[1:]
+
+    # Manifest of variant scales per asset file, read by the game at startup
+    manifest = {}
+    if os.path.exists(MANIFEST_FILE):
+        with open(MANIFEST_FILE) as f:
+            manifest = json.load(f)
+
+    os.makedirs(REGION_DIR, exist_ok=True)
+    for key, atlas in spec.items():
+        if not wanted(key):
+            continue
+        region_file = "json/atlases/%s.json" % key
+        write_asset_file(region_file, {"textures": {key: build_atlas(key, atlas)}})
+        for scale in atlas.get("scales", []):
+            entry = build_atlas(key, atlas, scale)
+            write_asset_file(variant_path(region_file, scale), {"textures": {key: entry}})
+        if "scales" in atlas:
+            manifest[region_file] = {"tile": atlas["tile"], "scales": atlas["scales"]}
+
+    for path, files in variant_spec.items():
+        if not wanted(path):
+            continue
+        build_variants(path, files)
+        manifest[path] = {"tile": files["tile"], "scales": files["scales"]}
+
+    write_asset_file(os.path.relpath(MANIFEST_FILE, ASSET_DIR), manifest)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
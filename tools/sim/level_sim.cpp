@@ -0,0 +1,128 @@
+//
+//  level_sim.cpp
+//  PolarPairs
+//
+//  Solves levels with the game's own level format and movement rules
+//  (PuzzleBoard), without a window, GL or audio. For each level file it
+//  prints the fewest swipes that win, the bear and seal moves of that
+//  solution against the level's targets, and how fast the rules ran, so
+//  it doubles as a check that edited levels are still solvable and as a
+//  benchmark of the rules code.
+//
+//  Built by the headless CMake configuration (see build/cmake):
+//
+//      level_sim assets/levels/level*.txt
+//
+//  The exit status is 1 if any level could not be read or solved.
+//
+
+#include "PuzzleBoard.h"
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+/** Give up on a level after this many distinct boards */
+static const size_t MAX_STATES = 2000000;
+
+static const cugl::Vec2 DIRECTIONS[4] = {
+    cugl::Vec2(1, 0), cugl::Vec2(-1, 0), cugl::Vec2(0, 1), cugl::Vec2(0, -1)
+};
+static const char* DIRECTION_NAMES = "RLUD";
+
+/** Identifies a board by the animal positions and the blocks broken so far */
+static std::string keyOf(const PuzzleBoard& board) {
+    std::string key;
+    key.push_back((char)board.getBearPos().x);
+    key.push_back((char)board.getBearPos().y);
+    key.push_back((char)board.getPenguinPos().x);
+    key.push_back((char)board.getPenguinPos().y);
+    for (int x = 0; x < GRID_WIDTH; x++) {
+        for (int y = 0; y < GRID_HEIGHT; y++) {
+            if (board.getCell(x, y) == 8) {
+                key.push_back((char)(x * GRID_HEIGHT + y));
+            }
+        }
+    }
+    return key;
+}
+
+/** Breadth-first search for the fewest swipes; returns false if there is no solution */
+static bool solve(const PuzzleBoard& start, std::string& swipes, PuzzleBoard& end, size_t& states) {
+    struct Visit {
+        std::string parent;
+        char swipe;
+    };
+    std::unordered_map<std::string, Visit> visited;
+    std::deque<PuzzleBoard> frontier;
+
+    visited[keyOf(start)] = { "", 0 };
+    frontier.push_back(start);
+    while (!frontier.empty() && visited.size() < MAX_STATES) {
+        PuzzleBoard board = frontier.front();
+        frontier.pop_front();
+        if (board.isWon()) {
+            // Walk back to the start for the swipe sequence
+            end = board;
+            std::string key = keyOf(board);
+            swipes.clear();
+            while (visited[key].swipe) {
+                swipes.insert(swipes.begin(), visited[key].swipe);
+                key = visited[key].parent;
+            }
+            states = visited.size();
+            return true;
+        }
+
+        std::string parent = keyOf(board);
+        for (int d = 0; d < 4; d++) {
+            PuzzleBoard next = board;
+            next.apply(next.plan(DIRECTIONS[d]));
+            std::string key = keyOf(next);
+            if (visited.find(key) == visited.end()) {
+                visited[key] = { parent, DIRECTION_NAMES[d] };
+                frontier.push_back(next);
+            }
+        }
+    }
+    states = visited.size();
+    return false;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("usage: %s <level.txt>...\n", argv[0]);
+        return 1;
+    }
+
+    int failed = 0;
+    for (int i = 1; i < argc; i++) {
+        LevelData data;
+        if (!LevelData::loadFile(data, argv[i])) {
+            printf("%s: could not read level\n", argv[i]);
+            failed++;
+            continue;
+        }
+
+        PuzzleBoard board;
+        board.load(data);
+        std::string swipes;
+        PuzzleBoard end;
+        size_t states = 0;
+        auto start = std::chrono::steady_clock::now();
+        bool solved = solve(board, swipes, end, states);
+        float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (!solved) {
+            printf("%s (%s): no solution in %zu boards, %.1f ms\n", argv[i], data.name.c_str(), states, ms);
+            failed++;
+            continue;
+        }
+        printf("%s (%s): %zu swipes %s  bear %d/%d  seal %d/%d  %d stars  (%zu boards, %.1f ms, %.0f boards/ms)\n",
+               argv[i], data.name.c_str(), swipes.size(), swipes.c_str(),
+               end.getBearMoves(), end.getBearPar(), end.getPenguinMoves(), end.getPenguinPar(),
+               end.getScore(), states, ms, ms > 0 ? states / ms : 0.0f);
+    }
+    return failed ? 1 : 0;
+}
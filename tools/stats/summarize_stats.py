@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+#
+#  summarize_stats.py
+#  PolarPairs
+#
+#  Offline summary of the gameplay statistics the game keeps in its save
+#  directory (see source/StatsLog.h for the format). stats.bin holds the
+#  per-level totals from the last compaction and stats.log the events since.
+#  The tool adds the two up the same way the game does and prints one row
+#  per level: attempts, restarts, wins, quits, best and average win time,
+#  best move count and how many wins earned each star count.
+#
+#  Pull the save directory from a device (for example with adb pull or the
+#  Xcode container download) and point the tool at it:
+#
+#      python3 tools/stats/summarize_stats.py <save directory> [--events]
+#
+#  --events also lists the events still in the log, oldest first.
+#
+import os
+import struct
+import sys
+import time
+import zlib
+
+VERSION = 1
+LOG_MAGIC = b"PPSL"
+TOTALS_MAGIC = b"PPSA"
+LOG_HEADER = struct.Struct("<4sHHI")
+RECORD = struct.Struct("<IHBBII")
+TOTALS_HEADER = struct.Struct("<4sHHI")
+TOTALS_ENTRY = struct.Struct("<HIIIIIIQ4I")
+EVENTS = ["start", "restart", "win", "quit"]
+
+
+def new_stats():
+    return {"attempts": 0, "restarts": 0, "wins": 0, "quits": 0,
+            "best_ms": 0, "best_moves": 0, "win_ms": 0, "stars": [0, 0, 0, 0]}
+
+
+def read_totals(path, totals):
+    """Adds the totals file to totals; returns its generation, or 0."""
+    if not os.path.exists(path):
+        return 0
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < TOTALS_HEADER.size + 4 or data[:4] != TOTALS_MAGIC:
+        print("warning: %s is not a stats totals file" % path, file=sys.stderr)
+        return 0
+    (crc,) = struct.unpack_from("<I", data, len(data) - 4)
+    if zlib.crc32(data[:-4]) & 0xFFFFFFFF != crc:
+        print("warning: %s fails its checksum" % path, file=sys.stderr)
+        return 0
+    _, version, count, generation = TOTALS_HEADER.unpack_from(data, 0)
+    if version != VERSION or TOTALS_HEADER.size + count * TOTALS_ENTRY.size + 4 != len(data):
+        print("warning: %s has an unknown version or size" % path, file=sys.stderr)
+        return 0
+    for i in range(count):
+        fields = TOTALS_ENTRY.unpack_from(data, TOTALS_HEADER.size + i * TOTALS_ENTRY.size)
+        stats = totals.setdefault(fields[0], new_stats())
+        (stats["attempts"], stats["restarts"], stats["wins"], stats["quits"],
+         stats["best_ms"], stats["best_moves"], stats["win_ms"]) = fields[1:8]
+        stats["stars"] = list(fields[8:12])
+    return generation
+
+
+def read_log(path, generation):
+    """Returns the log records, skipping a log already in the totals."""
+    if not os.path.exists(path):
+        return []
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < LOG_HEADER.size or data[:4] != LOG_MAGIC:
+        print("warning: %s is not a stats log" % path, file=sys.stderr)
+        return []
+    _, version, _, log_generation = LOG_HEADER.unpack_from(data, 0)
+    if version != VERSION or log_generation < generation:
+        return []
+    records = []
+    end = len(data) - (len(data) - LOG_HEADER.size) % RECORD.size
+    for offset in range(LOG_HEADER.size, end, RECORD.size):
+        records.append(RECORD.unpack_from(data, offset))
+    if end != len(data):
+        print("warning: %s ends in a partial record" % path, file=sys.stderr)
+    return records
+
+
+def apply(totals, record):
+    _, level, event, stars, play_ms, moves = record
+    stats = totals.setdefault(level, new_stats())
+    if event in (0, 1):
+        stats["attempts"] += 1
+        stats["restarts"] += event
+    elif event == 2:
+        stats["wins"] += 1
+        stats["win_ms"] += play_ms
+        if stats["best_ms"] == 0 or play_ms < stats["best_ms"]:
+            stats["best_ms"] = max(1, play_ms)
+        if stats["best_moves"] == 0 or moves < stats["best_moves"]:
+            stats["best_moves"] = moves
+        stats["stars"][min(stars, 3)] += 1
+    elif event == 3:
+        stats["quits"] += 1
+
+
+def main(argv):
+    args = [a for a in argv[1:] if not a.startswith("--")]
+    if len(args) != 1:
+        print("usage: %s <save directory> [--events]" % argv[0], file=sys.stderr)
+        return 1
+    directory = args[0]
+
+    totals = {}
+    generation = read_totals(os.path.join(directory, "stats.bin"), totals)
+    records = read_log(os.path.join(directory, "stats.log"), generation)
+    for record in records:
+        apply(totals, record)
+
+    print("%5s %8s %8s %5s %5s %9s %9s %6s  %s" % (
+        "level", "attempts", "restarts", "wins", "quits", "best s", "avg s", "moves", "stars 0/1/2/3"))
+    for level in sorted(totals):
+        stats = totals[level]
+        average = stats["win_ms"] / stats["wins"] / 1000.0 if stats["wins"] else 0.0
+        print("%5d %8d %8d %5d %5d %9.1f %9.1f %6d  %s" % (
+            level, stats["attempts"], stats["restarts"], stats["wins"], stats["quits"],
+            stats["best_ms"] / 1000.0, average, stats["best_moves"],
+            "/".join(str(n) for n in stats["stars"])))
+    print("%d levels, %d events not yet compacted" % (len(totals), len(records)))
+
+    if "--events" in argv:
+        for when, level, event, stars, play_ms, moves in records:
+            stamp = time.strftime("%Y-%m-%d %H:%M:%S", time.localtime(when))
+            name = EVENTS[event] if event < len(EVENTS) else "?"
+            print("%s  level %d %-7s stars %d  %.1f s  %d moves" % (
+                stamp, level, name, stars, play_ms / 1000.0, moves))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
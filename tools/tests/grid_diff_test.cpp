@@ -0,0 +1,92 @@
+//
+//  grid_diff_test.cpp
+//  PolarPairs
+//
+//  Checks the cell changes GridDiff hands the renderer: equal grids give
+//  none, each changed cell is reported once in column order with the right
+//  kind, the animated flag is passed through, and grids of different sizes
+//  give no changes so the renderer redraws the whole board.
+//
+//  Built by the CMake configuration (see build/cmake) and run by ctest.
+//  The exit status is 1 if a check fails.
+//
+
+#include "GridDiff.h"
+#include <cstdio>
+
+typedef std::vector<std::vector<int>> Grid;
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+/** Returns a grid of the given size filled with one cell type */
+static Grid makeGrid(int width, int height, int cellType) {
+    return Grid(width, std::vector<int>(height, cellType));
+}
+
+static void testSameSize() {
+    Grid from = makeGrid(7, 11, 0);
+    check(GridDiff::diff(from, from, true).empty(), "equal grids give no changes");
+
+    // One change of each kind, listed out of column order
+    Grid to = from;
+    to[4][2] = 6;    // Floor to breakable: both draw something
+    to[1][9] = 1;    // Floor to block: nothing drawn after
+    from[2][3] = 7;  // Invisible block to floor: nothing drawn before
+    to[2][3] = 0;
+    from[5][5] = 1;  // Block to invisible block: nothing drawn either way
+    to[5][5] = 7;
+
+    std::vector<GridDiff::Change> changes = GridDiff::diff(from, to, false);
+    check(changes.size() == 4, "each changed cell is reported once");
+    if (changes.size() != 4) {
+        return;
+    }
+    check(changes[0].x == 1 && changes[1].x == 2 && changes[2].x == 4 && changes[3].x == 5,
+          "changes come in column order");
+
+    check(changes[0].y == 9 && changes[0].from == 0 && changes[0].to == 1, "block change has its cell and types");
+    check(changes[0].kind == GridDiff::Kind::REMOVE, "floor to block is a remove");
+    check(changes[1].kind == GridDiff::Kind::ADD, "invisible block to floor is an add");
+    check(changes[2].kind == GridDiff::Kind::RETYPE, "floor to breakable is a retype");
+    check(changes[3].kind == GridDiff::Kind::RETYPE, "block to invisible block is a retype");
+
+    bool anyAnimated = false;
+    for (const auto& change : changes) {
+        anyAnimated = anyAnimated || change.animated;
+    }
+    check(!anyAnimated, "changes are not animated unless asked");
+
+    changes = GridDiff::diff(from, to, true);
+    bool allAnimated = changes.size() == 4;
+    for (const auto& change : changes) {
+        allAnimated = allAnimated && change.animated;
+    }
+    check(allAnimated, "animated diff marks every change animated");
+}
+
+static void testResized() {
+    Grid from = makeGrid(7, 11, 0);
+    check(GridDiff::diff(from, makeGrid(8, 11, 1), true).empty(), "wider grid gives no changes");
+    check(GridDiff::diff(from, makeGrid(7, 12, 1), true).empty(), "taller grid gives no changes");
+    check(GridDiff::diff(Grid(), from, false).empty(), "empty grid gives no changes");
+
+    // A column of another height anywhere makes the grids different sizes
+    Grid ragged = makeGrid(7, 11, 1);
+    ragged[6].push_back(1);
+    check(GridDiff::diff(from, ragged, false).empty(), "grid with a longer column gives no changes");
+}
+
+int main() {
+    testSameSize();
+    testResized();
+
+    printf("%s\n", failures ? "grid_diff_test failed" : "grid_diff_test passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+//
+//  lockstep_test.cpp
+//  PolarPairs
+//
+//  Checks the co-op lockstep handshake over an in-memory transport: a READY
+//  left over from an earlier round of the same level must not tie a new
+//  round to the old one, a peer that starts the level over or whose
+//  process restarts must be followed, and both players must still run the
+//  same frames.
+//
+//  Built by the CMake configuration (see build/cmake) and run by ctest.
+//  The exit status is 1 if a check fails.
+//
+
+#include "LockstepSession.h"
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+typedef std::deque<std::vector<uint8_t>> Queue;
+
+/** One end of a lossless in-memory link */
+class PipeTransport : public LockstepTransport {
+private:
+    Queue* _in;
+    Queue* _out;
+
+public:
+    /** Copies of the READY packets sent, to replay later */
+    std::vector<std::vector<uint8_t>> readies;
+
+    PipeTransport(Queue* in, Queue* out) : _in(in), _out(out) {}
+    bool isOpen() override { return true; }
+    bool isClosed() override { return false; }
+    void send(const std::vector<uint8_t>& data) override {
+        if (!data.empty() && data[0] == 1) {
+            readies.push_back(data);
+        }
+        _out->push_back(data);
+    }
+    bool receive(std::vector<uint8_t>& data) override {
+        if (_in->empty()) {
+            return false;
+        }
+        data = _in->front();
+        _in->pop_front();
+        return true;
+    }
+    void close() override {}
+};
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+/** Runs both players until both are on the level, or a frame budget runs out */
+static void start(LockstepSession& bear, LockstepSession& penguin) {
+    for (int i = 0; i < 600 && !(bear.isRunning() && penguin.isRunning()); i++) {
+        bear.update(LockstepSession::FRAME_SECONDS);
+        penguin.update(LockstepSession::FRAME_SECONDS);
+    }
+}
+
+/** Runs both players until each has taken want steps, or a frame budget runs out */
+static void play(LockstepSession& bear, LockstepSession& penguin,
+                 std::vector<LockstepSession::Step>& bearSteps,
+                 std::vector<LockstepSession::Step>& penguinSteps, size_t want) {
+    LockstepSession::Step step;
+    for (int i = 0; i < 600 && (bearSteps.size() < want || penguinSteps.size() < want); i++) {
+        bear.update(LockstepSession::FRAME_SECONDS);
+        penguin.update(LockstepSession::FRAME_SECONDS);
+        while (bear.pop(step)) bearSteps.push_back(step);
+        while (penguin.pop(step)) penguinSteps.push_back(step);
+    }
+}
+
+static bool sameSteps(const std::vector<LockstepSession::Step>& a, const std::vector<LockstepSession::Step>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].frame != b[i].frame || a[i].bear != b[i].bear || a[i].penguin != b[i].penguin) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    Queue toBear, toPenguin;
+    PipeTransport bearLink(&toBear, &toPenguin);
+    PipeTransport penguinLink(&toPenguin, &toBear);
+    LockstepSession bear, penguin;
+    bear.init(&bearLink, LockstepSession::Role::BEAR);
+    penguin.init(&penguinLink, LockstepSession::Role::PENGUIN);
+
+    // First round of level 1
+    bear.begin(1);
+    penguin.begin(1);
+    std::vector<LockstepSession::Step> bearSteps, penguinSteps;
+    start(bear, penguin);
+    check(bear.isRunning() && penguin.isRunning(), "first round starts");
+    bear.submit(0);
+    play(bear, penguin, bearSteps, penguinSteps, 1);
+    check(!bearSteps.empty() && bearSteps[0].bear == 0, "first round runs the bear's swipe");
+    check(sameSteps(bearSteps, penguinSteps), "first round steps agree");
+    check(!bearLink.readies.empty(), "bear sent a READY");
+    std::vector<uint8_t> stale = bearLink.readies.front();
+
+    // Both leave and start the level again; the old READY arrives late
+    bear.end();
+    penguin.end();
+    toBear.clear();
+    toPenguin.clear();
+    bear.begin(1);
+    penguin.begin(1);
+    toPenguin.push_back(stale);
+    penguin.update(LockstepSession::FRAME_SECONDS);
+    check(penguin.isWaiting(), "stale READY is ignored");
+
+    // The real round still starts and both players run the same frames
+    bearSteps.clear();
+    penguinSteps.clear();
+    start(bear, penguin);
+    check(bear.isRunning() && penguin.isRunning(), "second round starts");
+    bear.submit(2);
+    penguin.submit(3);
+    play(bear, penguin, bearSteps, penguinSteps, 1);
+    check(!bearSteps.empty() && bearSteps[0].bear == 2 && bearSteps[0].penguin == 3,
+          "second round runs both swipes");
+    check(sameSteps(bearSteps, penguinSteps), "second round steps agree");
+
+    // The penguin starts the level over while the bear is still running it
+    penguin.end();
+    penguin.begin(1);
+    bearSteps.clear();
+    penguinSteps.clear();
+    start(bear, penguin);
+    check(bear.isRunning() && penguin.isRunning(), "restarted round starts");
+    check(bear.takeRestart(), "bear is told the round restarted");
+    check(!penguin.takeRestart(), "penguin restarted on its own");
+    penguin.submit(0);
+    play(bear, penguin, bearSteps, penguinSteps, 1);
+    check(!bearSteps.empty() && bearSteps[0].penguin == 0, "restarted round runs the penguin's swipe");
+    check(sameSteps(bearSteps, penguinSteps), "restarted round steps agree");
+
+    // The penguin's process restarts: a new session counts rounds from 1 again
+    bear.end();
+    toBear.clear();
+    toPenguin.clear();
+    bear.begin(1);
+    PipeTransport restartedLink(&toPenguin, &toBear);
+    LockstepSession restarted;
+    restarted.init(&restartedLink, LockstepSession::Role::PENGUIN);
+    restarted.begin(1);
+    bearSteps.clear();
+    penguinSteps.clear();
+    start(bear, restarted);
+    check(bear.isRunning() && restarted.isRunning(), "restarted peer is let back in");
+    bear.submit(1);
+    play(bear, restarted, bearSteps, penguinSteps, 1);
+    check(!bearSteps.empty() && bearSteps[0].bear == 1, "restarted peer runs the bear's swipe");
+    check(sameSteps(bearSteps, penguinSteps), "restarted peer steps agree");
+
+    printf("%s\n", failures ? "lockstep_test failed" : "lockstep_test passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+//
+//  puzzle_board_test.cpp
+//  PolarPairs
+//
+//  Checks the board rules that plan and apply a swipe: animals slide until
+//  a wall or the other animal stops them, a swipe into a wall moves nothing
+//  and counts no move, a squeeze cracks a breakable block that then stays
+//  open, and reaching a finish tile ends the slide and is reported once.
+//
+//  Built by the CMake configuration (see build/cmake) and run by ctest.
+//  The exit status is 1 if a check fails.
+//
+
+#include "PuzzleBoard.h"
+#include <algorithm>
+#include <cstdio>
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+/** Loads a board from level file text */
+static bool loadBoard(PuzzleBoard& board, const std::string& text) {
+    LevelData data;
+    if (!LevelData::parseFromString(data, text)) {
+        return false;
+    }
+    board.load(data);
+    return true;
+}
+
+static const cugl::Vec2 UP(0, 1);
+static const cugl::Vec2 DOWN(0, -1);
+static const cugl::Vec2 RIGHT(1, 0);
+
+// Bear (B) and seal (S) on the bottom row, each under its finish (* and ^)
+static const char* OPEN_LEVEL =
+    "Open\n"
+    "7 11\n"
+    "XXXXXXX\n"
+    "X*...^X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "XB...SX\n"
+    "XXXXXXX\n"
+    "3\n"
+    "3\n";
+
+// Seal behind the bear, with breakable blocks (!) in front of and above the bear
+static const char* BREAK_LEVEL =
+    "Break\n"
+    "7 11\n"
+    "XXXXXXX\n"
+    "X....^X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "X.!...X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "X.....X\n"
+    "XSB!.*X\n"
+    "XXXXXXX\n"
+    "2\n"
+    "2\n";
+
+static void testBlocked() {
+    PuzzleBoard board;
+    check(loadBoard(board, OPEN_LEVEL), "open level parses");
+
+    // Both stand on the bottom row, so swiping down goes nowhere
+    PuzzleBoard::Move move = board.plan(DOWN);
+    check(move.bearTarget == board.getBearPos() && move.penguinTarget == board.getPenguinPos(),
+          "swipe into a wall plans no movement");
+    PuzzleBoard::Result result = board.apply(move);
+    check(!result.bearMoved && !result.penguinMoved, "swipe into a wall moves nothing");
+    check(board.getBearMoves() == 0 && board.getPenguinMoves() == 0, "swipe into a wall counts no move");
+}
+
+static void testSliding() {
+    PuzzleBoard board;
+    loadBoard(board, OPEN_LEVEL);
+
+    // The seal is already at the wall, so the bear slides over behind it
+    PuzzleBoard::Move move = board.plan(RIGHT);
+    check(move.penguinTarget == cugl::Vec2(5, 1), "front animal against the wall stays");
+    check(move.bearTarget == cugl::Vec2(4, 1), "rear animal stops behind the other");
+    check(!move.squeeze && move.breaks.empty(), "slide is not a squeeze");
+    PuzzleBoard::Result result = board.apply(move);
+    check(result.bearMoved && !result.penguinMoved, "only the bear moved");
+    check(board.getBearMoves() == 1 && board.getPenguinMoves() == 0, "only the bear's move counts");
+
+    // A held animal (the other player's, in co-op) stays put
+    move = board.plan(UP, true, false);
+    check(move.penguinTarget == board.getPenguinPos(), "held animal does not move");
+    check(move.bearTarget == cugl::Vec2(4, 9), "bear slides up to the wall");
+}
+
+static void testFinish() {
+    PuzzleBoard board;
+    loadBoard(board, OPEN_LEVEL);
+
+    // Both slide up their columns onto their finish tiles
+    PuzzleBoard::Result result = board.apply(board.plan(UP));
+    check(board.getBearPos() == cugl::Vec2(1, 9) && board.getPenguinPos() == cugl::Vec2(5, 9),
+          "animals stop on their finish tiles");
+    check(result.bearArrived && result.penguinArrived, "arrivals are reported");
+    check(result.together, "both slid together");
+    check(board.isWon(), "board is won");
+    check(board.getScore() == 3, "within par and together scores three stars");
+
+    // Finished animals hold still, and do not arrive again
+    PuzzleBoard::Move move = board.plan(DOWN);
+    check(move.bearTarget == board.getBearPos() && move.penguinTarget == board.getPenguinPos(),
+          "finished animals hold still");
+    result = board.apply(move);
+    check(!result.bearArrived && !result.penguinArrived, "arrival is reported once");
+}
+
+static void testBreakable() {
+    PuzzleBoard board;
+    check(loadBoard(board, BREAK_LEVEL), "break level parses");
+    check(board.getCell(3, 1) == 6 && board.getCell(2, 5) == 6, "breakable blocks load");
+
+    // A plain slide stops at a breakable block without cracking it
+    PuzzleBoard::Move move = board.plan(UP);
+    check(move.bearTarget == cugl::Vec2(2, 4), "plain slide stops under a breakable block");
+    check(move.breaks.empty(), "plain slide cracks nothing");
+
+    // The seal pushes into the bear, which is stopped by the block: a squeeze.
+    // The bear is pushed back, and the seal breaks through the block.
+    move = board.plan(RIGHT);
+    check(move.squeeze && move.bearPushed, "blocked front animal is squeezed back");
+    check(std::find(move.breaks.begin(), move.breaks.end(), cugl::Vec2(3, 1)) != move.breaks.end(),
+          "squeeze cracks the block");
+    check(move.bearTarget == cugl::Vec2(1, 1), "bear is pushed back to the wall");
+    check(move.penguinTarget == cugl::Vec2(4, 1), "seal slides through and stops at the bear finish");
+    board.apply(move);
+    check(board.getCell(3, 1) == 8, "cracked block is broken after the move");
+    check(board.getCell(2, 5) == 6, "other block is untouched");
+
+    // The broken block no longer stops anyone
+    move = board.plan(RIGHT, true, false);
+    check(move.bearTarget == cugl::Vec2(3, 1), "bear slides onto the broken block up to the seal");
+}
+
+int main() {
+    testBlocked();
+    testSliding();
+    testFinish();
+    testBreakable();
+
+    printf("%s\n", failures ? "puzzle_board_test failed" : "puzzle_board_test passed");
+    return failures ? 1 : 0;
+}